@@ -33,7 +33,10 @@ public class EmberFlight : ModuleRules
 				"UnrealEd",
 				"NiagaraEditor",
 				"EditorFramework",
-				"AssetTools"
+				"AssetTools",
+				"ToolMenus",
+				"Slate",
+				"SlateCore"
 			});
 		}
 
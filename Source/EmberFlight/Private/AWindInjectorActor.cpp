@@ -17,7 +17,7 @@ void AWindInjectorActor::BeginPlay()
     InjectorLocation = GetActorLocation();
     if (WindField)
     {
-        WindField->FieldOrigin = InjectorLocation;
+        WindField->SetFieldOrigin(InjectorLocation);
     }
 }
 
@@ -35,7 +35,7 @@ void AWindInjectorActor::Tick(float DeltaTime)
 
     if (bEnableInjection && WindField)
     {
-        WindField->FieldOrigin = InjectorLocation;
+        WindField->SetFieldOrigin(InjectorLocation);
         WindField->InjectWindAtPosition(InjectorLocation, VelocityToInject, Radius);
     }
 
@@ -68,7 +68,7 @@ void AWindInjectorActor::PostEditMove(bool bFinished)
     InjectorLocation = GetActorLocation();
     if (WindField)
     {
-        WindField->FieldOrigin = InjectorLocation;
+        WindField->SetFieldOrigin(InjectorLocation);
     }
     
     DrawTemporaryDebugSphere();
@@ -81,7 +81,7 @@ void AWindInjectorActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyC
     InjectorLocation = GetActorLocation();
     if (WindField) 
     {
-        WindField->FieldOrigin = InjectorLocation;
+        WindField->SetFieldOrigin(InjectorLocation);
     }
     
     DrawTemporaryDebugSphere();
@@ -94,7 +94,7 @@ void AWindInjectorActor::OnConstruction(const FTransform& Transform)
 
     InjectorLocation = GetActorLocation();
     if (WindField) {
-        WindField->FieldOrigin = InjectorLocation;
+        WindField->SetFieldOrigin(InjectorLocation);
     }
     //DrawTemporaryDebugSphere();
 }
@@ -5,10 +5,61 @@
 
 #include "AssetTypeActions_WindVectorField.h"
 #include "WindVectorField.h"
+#include "ToolMenuSection.h"
+#include "Misc/ScopedSlowTask.h"
+
+#define LOCTEXT_NAMESPACE "AssetTypeActions_WindVectorField"
 
 UClass* FAssetTypeActions_WindVectorField::GetSupportedClass() const
 {
     return UWindVectorField::StaticClass();
 }
 
-#endif
\ No newline at end of file
+void FAssetTypeActions_WindVectorField::GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section)
+{
+    const TArray<TWeakObjectPtr<UWindVectorField>> Fields = GetTypedWeakObjectPtrs<UWindVectorField>(InObjects);
+
+    Section.AddMenuEntry(
+        "WindVectorField_BakeSteadyState",
+        LOCTEXT("BakeSteadyState", "Bake Steady State"),
+        LOCTEXT("BakeSteadyStateTooltip", "Simulates the field until it settles and stores the grid in the asset, so loading skips the warm-up."),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateSP(this, &FAssetTypeActions_WindVectorField::ExecuteBakeSteadyState, Fields)));
+
+    Section.AddMenuEntry(
+        "WindVectorField_ClearSteadyState",
+        LOCTEXT("ClearSteadyState", "Clear Steady State"),
+        LOCTEXT("ClearSteadyStateTooltip", "Removes the baked steady state, the field warms up on load again."),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateSP(this, &FAssetTypeActions_WindVectorField::ExecuteClearSteadyState, Fields)));
+}
+
+void FAssetTypeActions_WindVectorField::ExecuteBakeSteadyState(TArray<TWeakObjectPtr<UWindVectorField>> Fields)
+{
+    FScopedSlowTask SlowTask(Fields.Num(), LOCTEXT("BakingSteadyState", "Baking wind steady state..."));
+    SlowTask.MakeDialog();
+
+    for (const TWeakObjectPtr<UWindVectorField>& Field : Fields)
+    {
+        SlowTask.EnterProgressFrame();
+        if (UWindVectorField* WindField = Field.Get())
+        {
+            WindField->BakeSteadyState();
+        }
+    }
+}
+
+void FAssetTypeActions_WindVectorField::ExecuteClearSteadyState(TArray<TWeakObjectPtr<UWindVectorField>> Fields)
+{
+    for (const TWeakObjectPtr<UWindVectorField>& Field : Fields)
+    {
+        if (UWindVectorField* WindField = Field.Get())
+        {
+            WindField->ClearSteadyState();
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
+
+#endif
@@ -17,6 +17,13 @@
 
 #define LOCTEXT_NAMESPACE "NiagaraWindFieldDI"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Grid Conversions"), STAT_WindField_NDIConversions, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Conversions Skipped"), STAT_WindField_NDIConversionsSkipped, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Uploads"), STAT_WindField_NDIUploads, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Uploads Skipped"), STAT_WindField_NDIUploadsSkipped, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Partial Uploads"), STAT_WindField_NDIPartialUploads, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("NDI Upload Bytes"), STAT_WindField_NDIUploadBytes, STATGROUP_WindField);
+
 static const FName SampleWindFieldName(TEXT("SampleWindAtLocation"));
 static const TCHAR* TemplateShaderFilePath = TEXT("/Plugin/Experimental/ChaosNiagara/NiagaraDataInterfaceWindField.ush");
 
@@ -24,36 +31,261 @@ UNiagaraDataInterfaceWindField::UNiagaraDataInterfaceWindField()
 {
 }
 
-void UNiagaraDataInterfaceWindField::SampleWindAtLocation(FVectorVMExternalFunctionContext& Context)
+// Interleaves the float SoA channels into the linear float4 layout the shader expects.
+// Scrolling grids are stored as a ring buffer, the rotation is undone here so the GPU always sees the window from FieldOrigin.
+// Fixed-rate fields are blended between their last two steps, the GPU only ever gets the interpolated grid.
+// Packed 16-bit grids are widened here, the shader always reads float4.
+// Tiled grids are untiled into plain X-major order.
+static void CopyWindGridToFloat4(const FWindGridView& View, FVector4f* RESTRICT Dst)
 {
-    //UE_LOG(LogTemp, Warning, TEXT("Sample Wind At Locations called"));
-    VectorVM::FUserPtrHandler<FNDIWindFieldInstanceData> InstanceData(Context);
-    if (!InstanceData.Get() || !InstanceData.Get()->WindField)
+    if (View.Layout == EWindGridLayout::Tiled)
     {
-        UE_LOG(LogTemp, Warning, TEXT("UNiagaraDataInterfaceWindField::SampleWindAtLocation called with invalid FieldHandler."));
+        // Tile rows are only four cells long, so cells are gathered one by one
+        int32 Out = 0;
+        for (int32 z = 0; z < View.SizeZ; ++z)
+        {
+            for (int32 y = 0; y < View.SizeY; ++y)
+            {
+                for (int32 x = 0; x < View.SizeX; ++x)
+                {
+                    Dst[Out++] = FVector4f(View.GetCell(View.GetIndex(x, y, z)), 0.0f);
+                }
+            }
+        }
         return;
     }
-    
-    FNDIInputParam<float> X(Context);
-    FNDIInputParam<float> Y(Context);
-    FNDIInputParam<float> Z(Context);
 
-    FNDIOutputParam<float> OutX(Context);
-    FNDIOutputParam<float> OutY(Context);
-    FNDIOutputParam<float> OutZ(Context);
+    if (View.RingOffset == FIntVector::ZeroValue)
+    {
+        View.DecodeRun(0, View.SizeX * View.SizeY * View.SizeZ, Dst);
+        return;
+    }
 
-    const int32 NumInstances = Context.GetNumInstances();
+    // Each storage row is rotated in X, so it is copied as two contiguous runs
+    const int32 SplitX = View.SizeX - View.RingOffset.X;
+    int32 Out = 0;
+    for (int32 z = 0; z < View.SizeZ; ++z)
+    {
+        for (int32 y = 0; y < View.SizeY; ++y)
+        {
+            const int32 RowFirst = View.GetIndex(0, y, z);
+            const int32 RowStart = RowFirst - View.RingOffset.X;
+            View.DecodeRun(RowFirst, SplitX, Dst + Out);
+            View.DecodeRun(RowStart, View.RingOffset.X, Dst + Out + SplitX);
+            Out += View.SizeX;
+        }
+    }
+}
+
+// Trilinear sample of a copied float4 grid in window order, the same clamping and addressing as FWindGridView::SampleGrid.
+// Index math runs four particles at a time, each corner is one float4 load so the three components lerp together.
+static void SampleWindSnapshot(const FNDIWindFieldGridInfo& Info, const FVector4f* RESTRICT Grid,
+    const float* RESTRICT PX, const float* RESTRICT PY, const float* RESTRICT PZ,
+    float* RESTRICT OutX, float* RESTRICT OutY, float* RESTRICT OutZ, int32 Count)
+{
+    const float InvCellSize = 1.0f / Info.CellSize;
+    const int32 RowStride = Info.Size.X;
+    const int32 SliceStride = Info.Size.X * Info.Size.Y;
+    int32 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+    // Cell indices are built in float lanes, which is exact as long as they fit the 24 bit mantissa
+    if (Info.NumCells() < (1 << 24))
+    {
+        const VectorRegister4Float InvCellSizeV = VectorSetFloat1(InvCellSize);
+        const VectorRegister4Float OffsetX = VectorSetFloat1(Info.GridOffset.X);
+        const VectorRegister4Float OffsetY = VectorSetFloat1(Info.GridOffset.Y);
+        const VectorRegister4Float OffsetZ = VectorSetFloat1(Info.GridOffset.Z);
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        const VectorRegister4Float One = VectorOneFloat();
+        const VectorRegister4Float MaxX = VectorSetFloat1((float)(Info.Size.X - 1));
+        const VectorRegister4Float MaxY = VectorSetFloat1((float)(Info.Size.Y - 1));
+        const VectorRegister4Float MaxZ = VectorSetFloat1((float)(Info.Size.Z - 1));
+        const VectorRegister4Float RowStrideV = VectorSetFloat1((float)RowStride);
+        const VectorRegister4Float SliceStrideV = VectorSetFloat1((float)SliceStride);
+
+        auto ClampV = [&Zero](const VectorRegister4Float& V, const VectorRegister4Float& Max)
+        {
+            return VectorMin(VectorMax(V, Zero), Max);
+        };
+
+        auto LerpV = [](const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& T)
+        {
+            return VectorMultiplyAdd(VectorSubtract(B, A), T, A);
+        };
 
-    for (int32 i = 0; i < NumInstances; ++i)
+        for (; i + 4 <= Count; i += 4)
+        {
+            const VectorRegister4Float GX = VectorSubtract(VectorMultiply(VectorLoad(PX + i), InvCellSizeV), OffsetX);
+            const VectorRegister4Float GY = VectorSubtract(VectorMultiply(VectorLoad(PY + i), InvCellSizeV), OffsetY);
+            const VectorRegister4Float GZ = VectorSubtract(VectorMultiply(VectorLoad(PZ + i), InvCellSizeV), OffsetZ);
+
+            const VectorRegister4Float FloorX = VectorFloor(GX);
+            const VectorRegister4Float FloorY = VectorFloor(GY);
+            const VectorRegister4Float FloorZ = VectorFloor(GZ);
+            const VectorRegister4Float X0 = ClampV(FloorX, MaxX);
+            const VectorRegister4Float Y0 = ClampV(FloorY, MaxY);
+            const VectorRegister4Float Z0 = ClampV(FloorZ, MaxZ);
+
+            // Steps to the upper corners, zero on the far faces where the upper corner clamps onto the lower one
+            const VectorRegister4Float StepX = VectorSubtract(ClampV(VectorAdd(FloorX, One), MaxX), X0);
+            const VectorRegister4Float StepY = VectorMultiply(VectorSubtract(ClampV(VectorAdd(FloorY, One), MaxY), Y0), RowStrideV);
+            const VectorRegister4Float StepZ = VectorMultiply(VectorSubtract(ClampV(VectorAdd(FloorZ, One), MaxZ), Z0), SliceStrideV);
+            const VectorRegister4Float Base = VectorMultiplyAdd(Z0, SliceStrideV, VectorMultiplyAdd(Y0, RowStrideV, X0));
+
+            alignas(16) int32 BaseIndex[4], DX[4], DY[4], DZ[4];
+            alignas(16) float SX[4], SY[4], SZ[4];
+            VectorIntStore(VectorFloatToInt(Base), BaseIndex);
+            VectorIntStore(VectorFloatToInt(StepX), DX);
+            VectorIntStore(VectorFloatToInt(StepY), DY);
+            VectorIntStore(VectorFloatToInt(StepZ), DZ);
+            VectorStoreAligned(VectorSubtract(GX, X0), SX);
+            VectorStoreAligned(VectorSubtract(GY, Y0), SY);
+            VectorStoreAligned(VectorSubtract(GZ, Z0), SZ);
+
+            alignas(16) float Result[4][4];
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const float* C = &Grid[BaseIndex[Lane]].X;
+                const int32 X1 = DX[Lane] * 4;
+                const int32 Y1 = DY[Lane] * 4;
+                const int32 Z1 = DZ[Lane] * 4;
+                const VectorRegister4Float WX = VectorSetFloat1(SX[Lane]);
+                const VectorRegister4Float C00 = LerpV(VectorLoad(C), VectorLoad(C + X1), WX);
+                const VectorRegister4Float C10 = LerpV(VectorLoad(C + Y1), VectorLoad(C + Y1 + X1), WX);
+                const VectorRegister4Float C01 = LerpV(VectorLoad(C + Z1), VectorLoad(C + Z1 + X1), WX);
+                const VectorRegister4Float C11 = LerpV(VectorLoad(C + Z1 + Y1), VectorLoad(C + Z1 + Y1 + X1), WX);
+                const VectorRegister4Float WY = VectorSetFloat1(SY[Lane]);
+                VectorStoreAligned(LerpV(LerpV(C00, C10, WY), LerpV(C01, C11, WY), VectorSetFloat1(SZ[Lane])), Result[Lane]);
+            }
+
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                OutX[i + Lane] = Result[Lane][0];
+                OutY[i + Lane] = Result[Lane][1];
+                OutZ[i + Lane] = Result[Lane][2];
+            }
+        }
+    }
+#endif
+
+    // Scalar remainder, or the whole run without vector intrinsics
+    for (; i < Count; ++i)
+    {
+        const FVector3f GridPos = FVector3f(PX[i], PY[i], PZ[i]) * InvCellSize - Info.GridOffset;
+        int32 x0 = FMath::FloorToInt(GridPos.X);
+        int32 y0 = FMath::FloorToInt(GridPos.Y);
+        int32 z0 = FMath::FloorToInt(GridPos.Z);
+        const int32 x1 = FMath::Clamp(x0 + 1, 0, Info.Size.X - 1);
+        const int32 y1 = FMath::Clamp(y0 + 1, 0, Info.Size.Y - 1);
+        const int32 z1 = FMath::Clamp(z0 + 1, 0, Info.Size.Z - 1);
+        x0 = FMath::Clamp(x0, 0, Info.Size.X - 1);
+        y0 = FMath::Clamp(y0, 0, Info.Size.Y - 1);
+        z0 = FMath::Clamp(z0, 0, Info.Size.Z - 1);
+
+        const float sx = GridPos.X - x0;
+        const float sy = GridPos.Y - y0;
+        const float sz = GridPos.Z - z0;
+        auto Cell = [&](int32 x, int32 y, int32 z) -> const FVector4f& { return Grid[x + y * RowStride + z * SliceStride]; };
+        const FVector4f C00 = FMath::Lerp(Cell(x0, y0, z0), Cell(x1, y0, z0), sx);
+        const FVector4f C10 = FMath::Lerp(Cell(x0, y1, z0), Cell(x1, y1, z0), sx);
+        const FVector4f C01 = FMath::Lerp(Cell(x0, y0, z1), Cell(x1, y0, z1), sx);
+        const FVector4f C11 = FMath::Lerp(Cell(x0, y1, z1), Cell(x1, y1, z1), sx);
+        const FVector4f Velocity = FMath::Lerp(FMath::Lerp(C00, C10, sy), FMath::Lerp(C01, C11, sy), sz);
+        OutX[i] = Velocity.X;
+        OutY[i] = Velocity.Y;
+        OutZ[i] = Velocity.Z;
+    }
+}
+
+// Particles are processed in blocks of this many, the staging for constant inputs and unused outputs lives on the stack
+static constexpr int32 VMSampleBlockSize = 256;
+
+// A streamed input register is read in place, a constant one is splatted into Scratch
+static const float* GetInputBlock(VectorVM::FExternalFuncInputHandler<float>& Input, int32 Start, int32 Count, float* Scratch)
+{
+    if (!Input.IsConstant())
+    {
+        return Input.GetDest() + Start;
+    }
+    const float Value = Input.Get();
+    for (int32 i = 0; i < Count; ++i)
     {
-        FVector WorldPos(X.GetAndAdvance(), Y.GetAndAdvance(), Z.GetAndAdvance());
-        FVector Velocity = InstanceData.Get()->WindField->SampleWindAtPosition(WorldPos);
+        Scratch[i] = Value;
+    }
+    return Scratch;
+}
+
+static float* GetOutputBlock(VectorVM::FExternalFuncRegisterHandler<float>& Output, int32 Start, float* Scratch)
+{
+    return Output.IsValid() ? Output.GetDest() + Start : Scratch;
+}
+
+void UNiagaraDataInterfaceWindField::SampleWindAtLocation(FVectorVMExternalFunctionContext& Context)
+{
+    VectorVM::FUserPtrHandler<FNDIWindFieldInstanceData> InstanceData(Context);
+    VectorVM::FExternalFuncInputHandler<float> InX(Context);
+    VectorVM::FExternalFuncInputHandler<float> InY(Context);
+    VectorVM::FExternalFuncInputHandler<float> InZ(Context);
+    VectorVM::FExternalFuncRegisterHandler<float> OutX(Context);
+    VectorVM::FExternalFuncRegisterHandler<float> OutY(Context);
+    VectorVM::FExternalFuncRegisterHandler<float> OutZ(Context);
+
+    const int32 NumInstances = Context.GetNumInstances();
+    const FNDIWindFieldInstanceData* Instance = InstanceData.Get();
+    UWindVectorField* Field = Instance ? Instance->WindField : nullptr;
+    const FNDIWindFieldData* DataOwner = Instance ? Instance->InstanceDataOwner : nullptr;
+
+    // Everything is validated once per call, the sampling loops below never check again
+    const int32 ReadIndex = DataOwner ? DataOwner->WriteIndex : 0;
+    const FNDIWindFieldGridInfo* Info = DataOwner ? &DataOwner->GridInfos[ReadIndex] : nullptr;
+    const FVector4f* Grid = DataOwner ? DataOwner->VelocityGridBuffers[ReadIndex].GetData() : nullptr;
 
-        //UE_LOG(LogTemp, Warning, TEXT("[Niagara] WindSample Velocity: X=%f Y=%f Z=%f"), Velocity.X, Velocity.Y, Velocity.Z);
+    // PerInstanceTick copied this frame's grid into the write buffer, it stays untouched until next frame's tick swaps.
+    // Clipmap levels are not in the copy, points outside the finest grid have to ask the field.
+    const bool bSnapshot = Field && Info && Info->NumCells() > 0 && Info->CellSize > 0.0f
+        && DataOwner->VelocityGridBuffers[ReadIndex].Num() >= Info->NumCells() && Field->GetNumClipmapLevels() == 1;
 
-        OutX.SetAndAdvance(Velocity.X);
-        OutY.SetAndAdvance(Velocity.Y);
-        OutZ.SetAndAdvance(Velocity.Z);
+    for (int32 Start = 0; Start < NumInstances; Start += VMSampleBlockSize)
+    {
+        const int32 Count = FMath::Min(VMSampleBlockSize, NumInstances - Start);
+        float ScratchX[VMSampleBlockSize], ScratchY[VMSampleBlockSize], ScratchZ[VMSampleBlockSize];
+        const float* PX = GetInputBlock(InX, Start, Count, ScratchX);
+        const float* PY = GetInputBlock(InY, Start, Count, ScratchY);
+        const float* PZ = GetInputBlock(InZ, Start, Count, ScratchZ);
+
+        float DiscardX[VMSampleBlockSize], DiscardY[VMSampleBlockSize], DiscardZ[VMSampleBlockSize];
+        float* VX = GetOutputBlock(OutX, Start, DiscardX);
+        float* VY = GetOutputBlock(OutY, Start, DiscardY);
+        float* VZ = GetOutputBlock(OutZ, Start, DiscardZ);
+
+        if (bSnapshot)
+        {
+            SampleWindSnapshot(*Info, Grid, PX, PY, PZ, VX, VY, VZ, Count);
+        }
+        else if (Field)
+        {
+            // Sparse and clipmapped fields, still one validity check per block rather than per particle
+            FVector3f Positions[VMSampleBlockSize];
+            FVector3f Velocities[VMSampleBlockSize];
+            for (int32 i = 0; i < Count; ++i)
+            {
+                Positions[i] = FVector3f(PX[i], PY[i], PZ[i]);
+            }
+            Field->SampleWindBatch(MakeArrayView(Positions, Count), MakeArrayView(Velocities, Count));
+            for (int32 i = 0; i < Count; ++i)
+            {
+                VX[i] = Velocities[i].X;
+                VY[i] = Velocities[i].Y;
+                VZ[i] = Velocities[i].Z;
+            }
+        }
+        else
+        {
+            FMemory::Memzero(VX, Count * sizeof(float));
+            FMemory::Memzero(VY, Count * sizeof(float));
+            FMemory::Memzero(VZ, Count * sizeof(float));
+        }
     }
 }
 
@@ -104,6 +336,7 @@ bool UNiagaraDataInterfaceWindField::CopyToInternal(UNiagaraDataInterface* Desti
     }
 
     DestTyped->WindField = this->WindField;
+    DestTyped->PartialUploadMaxFraction = this->PartialUploadMaxFraction;
 
     return true;
 }
@@ -111,7 +344,7 @@ bool UNiagaraDataInterfaceWindField::CopyToInternal(UNiagaraDataInterface* Desti
 bool UNiagaraDataInterfaceWindField::Equals(const UNiagaraDataInterface* Other) const
 {
     const UNiagaraDataInterfaceWindField* OtherTyped = CastChecked<UNiagaraDataInterfaceWindField>(Other);
-    return OtherTyped && OtherTyped->WindField == WindField;
+    return OtherTyped && OtherTyped->WindField == WindField && OtherTyped->PartialUploadMaxFraction == PartialUploadMaxFraction;
 }
 
 bool UNiagaraDataInterfaceWindField::CanExecuteOnTarget(ENiagaraSimTarget Target) const
@@ -143,32 +376,47 @@ bool UNiagaraDataInterfaceWindField::PerInstanceTick(void* PerInstanceData, FNia
 
     FNDIWindFieldData* DataOwner = InstanceData->InstanceDataOwner;
 
-    // Only write into current write buffer
+    // Every instance of the field shares the copy, the first tick of the frame makes it for all of them
+    FScopeLock Lock(&DataOwner->Lock);
+    if (DataOwner->LastTickFrame == GFrameCounter)
+    {
+        return true;
+    }
+    DataOwner->LastTickFrame = GFrameCounter;
+
+    // Swap buffers, the previous one may still be read by a render thread frame behind
+    DataOwner->WriteIndex = 1 - DataOwner->WriteIndex;
     int32 WriteIndex = DataOwner->WriteIndex;
     TArray<FVector4f>& WriteBuffer = DataOwner->VelocityGridBuffers[WriteIndex];
 
-    const TArray<FVector>& SourceGrid = InstanceData->WindField->GetVelocityGrid();
-    WriteBuffer.Reset(SourceGrid.Num());
-
-    for (const FVector& V : SourceGrid)
+    // Read before the view, a change published in between bumps it again and is picked up next tick
+    const uint64 GridVersion = DataOwner->WindField->GetGridVersion();
+    if (DataOwner->BufferVersions[WriteIndex] == GridVersion)
     {
-        WriteBuffer.Add(FVector4f(V.X, V.Y, V.Z, 0.0f));
+        INC_DWORD_STAT(STAT_WindField_NDIConversionsSkipped);
+        return true;
     }
+    INC_DWORD_STAT(STAT_WindField_NDIConversions);
 
-    return true; // request RT update
-}
+    // The view pins the last completed step, so this never waits on an async solver step
+    const FWindGridView View = DataOwner->WindField->GetGridView();
+    const int32 NumCells = View.IsValid() ? View.SizeX * View.SizeY * View.SizeZ : 0;
+    WriteBuffer.SetNumUninitialized(NumCells, EAllowShrinking::No);
 
-bool UNiagaraDataInterfaceWindField::PerInstanceTickPostSimulate(void* PerInstanceData, FNiagaraSystemInstance* InSystemInstance, float DeltaSeconds)
-{
-    FNDIWindFieldInstanceData* InstanceData = static_cast<FNDIWindFieldInstanceData*>(PerInstanceData);
-    if (!InstanceData || !InstanceData->InstanceDataOwner)
-        return false;
+    if (NumCells > 0)
+    {
+        CopyWindGridToFloat4(View, WriteBuffer.GetData());
+    }
+    DataOwner->GridInfos[WriteIndex].Set(View);
+    DataOwner->BufferVersions[WriteIndex] = GridVersion;
 
-    // Swap buffers after sim
-    FNDIWindFieldData* DataOwner = InstanceData->InstanceDataOwner;
-    DataOwner->WriteIndex = 1 - DataOwner->WriteIndex;
+    // A field still initializing in the background had no grid to size the buffer by when the instance was created
+    if (!DataOwner->AssetBuffer.IsValid() || DataOwner->AssetBuffer->NumElements < NumCells)
+    {
+        DataOwner->InitializeBufferIfNeeded(NumCells);
+    }
 
-    return false;
+    return true; // request RT update
 }
 
 int32 UNiagaraDataInterfaceWindField::PerInstanceDataSize() const
@@ -186,33 +434,15 @@ bool UNiagaraDataInterfaceWindField::InitPerInstanceData(void* PerInstanceData,
         return false;
     }
 
-    // Create per-instance owner data
-    FNDIWindFieldData* DataOwner = new FNDIWindFieldData();
-    DataOwner->WindField = WindField;
-    InstanceData->InstanceDataOwner = DataOwner;
-
     // Set field origin to the Niagara system's world location
     FVector SystemPos = SystemInstance->GetAttachComponent()->GetComponentLocation();
-    WindField->FieldOrigin = SystemPos;
+    WindField->SetFieldOrigin(SystemPos);
     /*UE_LOG(LogTemp, Warning, TEXT("[WindField] FieldOrigin set to %s for System %s"),
         *SystemPos.ToString(), *SystemInstance->GetSystem()->GetName());*/
 
-    // Initialize CPU velocity grids
-    const TArray<FVector>& SourceGrid = WindField->GetVelocityGrid();
-    for (int32 i = 0; i < 2; ++i)
-    {
-        DataOwner->VelocityGridBuffers[i].Reset(); // clear first
-        DataOwner->VelocityGridBuffers[i].Reserve(SourceGrid.Num());
-        for (const FVector& V : SourceGrid)
-        {
-            DataOwner->VelocityGridBuffers[i].Add(FVector4f(V.X, V.Y, V.Z, 0.0f));
-        }
-    }
+    // Shared with every other instance of this field, the first one creates the grids and the GPU buffer
+    InstanceData->InstanceDataOwner = FNDIWindFieldData::Acquire(WindField);
     InstanceData->WriteIndex = 0;
-    DataOwner->WriteIndex = 0;
-
-    // Initialize GPU buffer
-    DataOwner->InitializeBufferIfNeeded(SourceGrid.Num());
 
     return true;
 }
@@ -227,6 +457,21 @@ void UNiagaraDataInterfaceWindField::DestroyPerInstanceData(
     FNDIWindFieldInstanceData* InstanceData =
         static_cast<FNDIWindFieldInstanceData*>(PerInstanceData);
 
+    // The proxy entry points at the shared buffer, it has to go before the buffer is deleted on the render thread
+    if (SystemInstance)
+    {
+        ENQUEUE_RENDER_COMMAND(DestroyWindFieldProxyData)(
+            [Proxy = GetProxyAs<FNDIWindFieldProxy>(), InstanceID = SystemInstance->GetId()](FRHICommandListImmediate& RHICmdList)
+            {
+                Proxy->DestroyPerInstanceData(InstanceID);
+            });
+    }
+
+    if (InstanceData->InstanceDataOwner)
+    {
+        FNDIWindFieldData::Release(InstanceData->InstanceDataOwner);
+    }
+
     // Explicitly call destructor since memory is managed by Niagara
     InstanceData->~FNDIWindFieldInstanceData();
 }
@@ -309,25 +554,39 @@ void UNiagaraDataInterfaceWindField::SetShaderParameters(
     FNDIWindFieldBuffer* Buffer = RenderData->AssetBuffer;
     ShaderParameters->User_WindField_VelocityGridSRV =
         FNiagaraRenderer::GetSrvOrDefaultFloat4(Buffer ? Buffer->VelocityGridSRV : nullptr);
+}
 
-#if WITH_EDITOR
-    /*UE_LOG(LogTemp, Warning,
-        TEXT("[WindField] SetShaderParameters: SRV=%p Elements=%d Size=(%d,%d,%d)"),
-        (Buffer && Buffer->VelocityGridSRV.IsValid()) ? Buffer->VelocityGridSRV.GetReference() : nullptr,
-        RenderData->VelocityGridCount,
-        RenderData->SizeX, RenderData->SizeY, RenderData->SizeZ);*/
+bool FNDIWindFieldData::GatherUploadRanges(const UWindVectorField& Field, uint64 GpuVersion, const FNDIWindFieldGridInfo& Info,
+    int32 NumElements, float MaxFraction, TArray<FIntPoint>& OutRanges)
+{
+    TBitArray<> Slices;
+    if (MaxFraction <= 0.0f || GpuVersion == 0 || !Field.GetDirtySlices(GpuVersion, Slices)
+        || Slices.Num() != Info.Size.Z || Info.NumCells() != NumElements)
+    {
+        return false;
+    }
+
+    const int32 NumDirty = Slices.CountSetBits();
+    if (NumDirty > MaxFraction * Slices.Num())
+    {
+        return false;
+    }
 
-    if (RenderData->VelocityGridPtr && RenderData->VelocityGridCount > 0)
+    // Adjacent slices are contiguous in the copy, each run is one range
+    const int32 SliceCells = Info.Size.X * Info.Size.Y;
+    for (TConstSetBitIterator<> It(Slices); It; ++It)
     {
-        FString Sample;
-        for (int i = 0; i < FMath::Min(3, RenderData->VelocityGridCount); ++i)
+        const int32 First = It.GetIndex() * SliceCells;
+        if (OutRanges.Num() > 0 && OutRanges.Last().X + OutRanges.Last().Y == First)
         {
-            const FVector4f& V = RenderData->VelocityGridPtr[i];
-            Sample += FString::Printf(TEXT("[%.2f, %.2f, %.2f] "), V.X, V.Y, V.Z);
+            OutRanges.Last().Y += SliceCells;
+        }
+        else
+        {
+            OutRanges.Emplace(First, SliceCells);
         }
-        //UE_LOG(LogTemp, Warning, TEXT("[WindField] First 3 GPU buffer samples: %s"), *Sample);
     }
-#endif
+    return true;
 }
 
 void UNiagaraDataInterfaceWindField::ProvidePerInstanceDataForRenderThread(
@@ -346,13 +605,36 @@ void UNiagaraDataInterfaceWindField::ProvidePerInstanceDataForRenderThread(
 
     FNDIWindFieldData* DataOwner = InstanceData->InstanceDataOwner;
 
-    // --- Select the read buffer (double buffering) ---
-    const int32 ReadIndex = 1 - DataOwner->WriteIndex;
+    // --- Select the buffer copied this frame, the game thread writes the other one next frame ---
+    FScopeLock Lock(&DataOwner->Lock);
+    const int32 ReadIndex = DataOwner->WriteIndex;
     const TArray<FVector4f>& ReadBuffer = DataOwner->VelocityGridBuffers[ReadIndex];
 
-    // Instead of copying, just pass pointer + size
-    RenderData->VelocityGridPtr = ReadBuffer.GetData();
-    RenderData->VelocityGridCount = ReadBuffer.Num();
+    // Upload only a grid the GPU buffer does not hold yet, otherwise the render thread keeps what it has.
+    // The version is shared, so of all instances of the field only the first one queues it.
+    const uint64 ReadVersion = DataOwner->BufferVersions[ReadIndex];
+    if (ReadVersion != DataOwner->LastQueuedVersion)
+    {
+        // Instead of copying, just pass pointer + size
+        RenderData->VelocityGridPtr = ReadBuffer.GetData();
+        RenderData->VelocityGridCount = ReadBuffer.Num();
+        RenderData->bUploadQueuedThisFrame = true;
+        RenderData->PartialUploadMaxFraction = PartialUploadMaxFraction;
+
+        // Nothing changed at all is still an upload of nothing, so an empty list never gets mistaken for a full one
+        if (DataOwner->WindField && FNDIWindFieldData::GatherUploadRanges(*DataOwner->WindField, DataOwner->LastQueuedVersion,
+            DataOwner->GridInfos[ReadIndex], ReadBuffer.Num(), PartialUploadMaxFraction, RenderData->UploadRanges)
+            && RenderData->UploadRanges.Num() == 0)
+        {
+            RenderData->bUploadQueuedThisFrame = false;
+            INC_DWORD_STAT(STAT_WindField_NDIUploadsSkipped);
+        }
+        DataOwner->LastQueuedVersion = ReadVersion;
+    }
+    else
+    {
+        INC_DWORD_STAT(STAT_WindField_NDIUploadsSkipped);
+    }
 
     // --- Copy basic field info from the asset ---
     if (UWindVectorField* Field = DataOwner->WindField)
@@ -367,9 +649,6 @@ void UNiagaraDataInterfaceWindField::ProvidePerInstanceDataForRenderThread(
     // --- AssetBuffer is the raw pointer of the shared buffer ---
     RenderData->AssetBuffer = DataOwner->AssetBuffer.Get();
 
-    // --- Mark that this frame has new data ---
-    RenderData->bUploadQueuedThisFrame = true;
-
     /*UE_LOG(LogTemp, Warning, TEXT("[WindField] ProvidePerInstanceData: Prepared %d elements for instance %llu"),
         RenderData->VelocityGridCount, SystemInstance);*/
 }
@@ -394,11 +673,21 @@ void FNDIWindFieldProxy::ConsumePerInstanceDataFromGameThread(void* PerInstanceD
     TargetData.SizeY = SourceData->SizeY;
     TargetData.SizeZ = SourceData->SizeZ;
     TargetData.AssetBuffer = SourceData->AssetBuffer;
-    TargetData.bUploadQueuedThisFrame = SourceData->bUploadQueuedThisFrame;
 
-    // Just forward the pointer & size, no allocation/copy
-    TargetData.VelocityGridPtr = SourceData->VelocityGridPtr;
-    TargetData.VelocityGridCount = SourceData->VelocityGridCount;
+    // Just forward the pointer & size, no allocation/copy. The buffer is shared by every instance of the field,
+    // so the upload is parked on it. A frame with nothing new keeps an upload PreStage could not do yet pending.
+    if (SourceData->bUploadQueuedThisFrame)
+    {
+        TargetData.VelocityGridPtr = SourceData->VelocityGridPtr;
+        TargetData.VelocityGridCount = SourceData->VelocityGridCount;
+        if (FNDIWindFieldBuffer* Buffer = SourceData->AssetBuffer)
+        {
+            Buffer->QueueUpload(SourceData->VelocityGridPtr, SourceData->VelocityGridCount, SourceData->UploadRanges, SourceData->PartialUploadMaxFraction);
+        }
+    }
+
+    // Holds the range list, Niagara only frees the memory
+    SourceData->~FNDIWindFieldRenderData();
 
     /*UE_LOG(LogTemp, Warning, TEXT("[WindField] ConsumePerInstanceData: Instance %llu -> %d elements, zero-copy"),
         Instance, TargetData.VelocityGridCount);*/
@@ -412,44 +701,65 @@ void FNDIWindFieldProxy::PreStage(const FNDIGpuComputePreStageContext& Context)
     if (!RenderData || !RenderData->AssetBuffer)
         return;
 
+    // Unchanged field, or another instance sharing the buffer uploaded it already
     FNDIWindFieldBuffer* Buffer = RenderData->AssetBuffer;
+    if (!Buffer->PendingUpload)
+        return;
+
     if (!Buffer->VelocityGridBufferRHI.IsValid())
         return; // Avoid crash if InitRHI not done yet
 
-    const int32 NumElements = RenderData->VelocityGridCount;
-    if (NumElements == 0 || !RenderData->VelocityGridPtr)
+    const int32 NumElements = Buffer->PendingUploadCount;
+    if (NumElements == 0)
         return;
 
-    //UE_LOG(LogTemp, Warning, TEXT("[WindField::PreStage] Called. NumElements=%d"), NumElements);
+    // Queued on the graph rather than locked on the immediate command list, so it goes through the graph's
+    // upload staging with the other initial data and never stalls the render thread. The first stage of the
+    // frame queues it, every later stage of any emitter sharing the buffer finds nothing pending.
+    FRDGBuilder& GraphBuilder = Context.GetGraphBuilder();
+    FRDGBufferRef VelocityGrid = GraphBuilder.RegisterExternalBuffer(Buffer->VelocityGridPooledBuffer);
+    INC_DWORD_STAT_BY(STAT_WindField_NDIUploadBytes, Buffer->GetPendingUploadBytes());
 
-#if WITH_EDITOR
-    FString Sample;
-    for (int i = 0; i < FMath::Min(5, NumElements); ++i)
+    if (Buffer->PendingUploadRanges.Num() == 0)
     {
-        const FVector4f& V = RenderData->VelocityGridPtr[i];
-        Sample += FString::Printf(TEXT("[%.2f, %.2f, %.2f] "), V.X, V.Y, V.Z);
+        // No copy: the game thread writes this grid again two frames from now, the graph has executed by then
+        GraphBuilder.QueueBufferUpload(VelocityGrid, Buffer->PendingUpload, NumElements * sizeof(FVector4f), ERDGInitialDataFlags::NoCopy);
     }
-    //UE_LOG(LogTemp, Warning, TEXT("[WindField::PreStage] First 5 velocities: %s"), *Sample);
-#endif
-
-    Buffer->NumElements = NumElements;
+    else
+    {
+        // The changed ranges are packed into one upload buffer and copied into place, a pass per range
+        int32 NumPacked = 0;
+        for (const FIntPoint& Range : Buffer->PendingUploadRanges)
+        {
+            NumPacked += Range.Y;
+        }
+        FVector4f* Packed = GraphBuilder.AllocPODArray<FVector4f>(NumPacked);
+        int32 PackedOffset = 0;
+        for (const FIntPoint& Range : Buffer->PendingUploadRanges)
+        {
+            FMemory::Memcpy(Packed + PackedOffset, Buffer->PendingUpload + Range.X, Range.Y * sizeof(FVector4f));
+            PackedOffset += Range.Y;
+        }
 
-    FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+        FRDGBufferRef Upload = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateUploadDesc(sizeof(FVector4f), NumPacked), TEXT("WindField.ChangedSlices"));
+        GraphBuilder.QueueBufferUpload(Upload, Packed, NumPacked * sizeof(FVector4f), ERDGInitialDataFlags::NoCopy);
 
-    // Direct memcpy from GT double buffer to GPU buffer
-    void* Dest = RHICmdList.LockBuffer(
-        Buffer->VelocityGridBufferRHI,
-        0,
-        Buffer->NumElements * sizeof(FVector4f),
-        RLM_WriteOnly
-    );
-    FMemory::Memcpy(Dest, RenderData->VelocityGridPtr, Buffer->NumElements * sizeof(FVector4f));
-    RHICmdList.UnlockBuffer(Buffer->VelocityGridBufferRHI);
+        PackedOffset = 0;
+        for (const FIntPoint& Range : Buffer->PendingUploadRanges)
+        {
+            AddCopyBufferPass(GraphBuilder, VelocityGrid, Range.X * sizeof(FVector4f), Upload, PackedOffset * sizeof(FVector4f), Range.Y * sizeof(FVector4f));
+            PackedOffset += Range.Y;
+        }
+        Buffer->PendingUploadRanges.Reset();
+        INC_DWORD_STAT(STAT_WindField_NDIPartialUploads);
+    }
 
-    RenderData->bUploadQueuedThisFrame = false;
+    // The shaders bind the SRV directly, outside of the graph's tracking, so it has to leave the graph readable
+    GraphBuilder.UseExternalAccessMode(VelocityGrid, ERHIAccess::SRVMask);
 
-    /*UE_LOG(LogTemp, Warning, TEXT("[WindField::PreStage] Upload complete to RHI buffer=%p"),
-        Buffer->VelocityGridBufferRHI.GetReference());*/
+    Buffer->PendingUpload = nullptr;
+    Buffer->PendingUploadCount = 0;
+    INC_DWORD_STAT(STAT_WindField_NDIUploads);
 }
 
 void FNDIWindFieldProxy::InitializePerInstanceData(const FNiagaraSystemInstanceID& SystemInstance)
@@ -485,6 +795,9 @@ void FNDIWindFieldData::InitializeBufferIfNeeded(int32 NumElements)
     AssetBuffer = MakeShared<FNDIWindFieldBuffer, ESPMode::ThreadSafe>();
     AssetBuffer->NumElements = NumElements;
 
+    // A new buffer holds no grid, the next read buffer is uploaded whatever its version
+    LastQueuedVersion = 0;
+
     // This schedules InitRHI on render thread
     BeginInitResource(AssetBuffer.Get());
 
@@ -508,6 +821,118 @@ void FNDIWindFieldData::ReleaseBuffer()
     }
 }
 
+// Shared data per field. Instances are created and destroyed on the game thread, but not necessarily only there.
+static FCriticalSection SharedWindFieldDataLock;
+static TMap<const UWindVectorField*, FNDIWindFieldData*> SharedWindFieldData;
+
+FNDIWindFieldData* FNDIWindFieldData::Acquire(UWindVectorField* Field)
+{
+    check(Field);
+    FScopeLock RegistryLock(&SharedWindFieldDataLock);
+
+    FNDIWindFieldData*& Data = SharedWindFieldData.FindOrAdd(Field);
+    if (!Data)
+    {
+        Data = new FNDIWindFieldData();
+        Data->WindField = Field;
+
+        // Initialize CPU velocity grids
+        const uint64 GridVersion = Field->GetGridVersion();
+        const FWindGridView SourceGrid = Field->GetGridView();
+        const int32 NumCells = SourceGrid.IsValid() ? SourceGrid.SizeX * SourceGrid.SizeY * SourceGrid.SizeZ : 0;
+        for (int32 i = 0; i < 2; ++i)
+        {
+            Data->VelocityGridBuffers[i].SetNumUninitialized(NumCells);
+            if (NumCells > 0)
+            {
+                CopyWindGridToFloat4(SourceGrid, Data->VelocityGridBuffers[i].GetData());
+            }
+            Data->GridInfos[i].Set(SourceGrid);
+            Data->BufferVersions[i] = GridVersion;
+        }
+
+        // Initialize GPU buffer
+        Data->InitializeBufferIfNeeded(NumCells);
+    }
+    ++Data->NumUsers;
+    return Data;
+}
+
+void FNDIWindFieldData::Release(FNDIWindFieldData* Data)
+{
+    FScopeLock RegistryLock(&SharedWindFieldDataLock);
+    if (--Data->NumUsers > 0)
+    {
+        return;
+    }
+    SharedWindFieldData.Remove(Data->WindField);
+
+    // The render thread may still hold an upload pointing into the CPU grids, they go after the buffer
+    Data->ReleaseBuffer();
+    ENQUEUE_RENDER_COMMAND(DeleteWindFieldData)(
+        [Data](FRHICommandListImmediate& RHICmdList)
+        {
+            delete Data;
+        });
+}
+
+void FNDIWindFieldBuffer::QueueUpload(const FVector4f* Grid, int32 Count, TConstArrayView<FIntPoint> Ranges, float MaxFraction)
+{
+    const bool bFullUpload = Ranges.Num() == 0 || (PendingUpload && PendingUploadRanges.Num() == 0);
+    if (bFullUpload)
+    {
+        PendingUploadRanges.Reset();
+    }
+    else
+    {
+        // Frames PreStage skipped pile up the same slices, kept sorted and merged so every cell is sent once
+        PendingUploadRanges.Append(Ranges.GetData(), Ranges.Num());
+        PendingUploadRanges.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.X < B.X; });
+        int32 NumMerged = 0;
+        int64 NumRangeCells = 0;
+        for (int32 Index = 0; Index < PendingUploadRanges.Num(); ++Index)
+        {
+            const FIntPoint Range = PendingUploadRanges[Index];
+            FIntPoint* Last = NumMerged > 0 ? &PendingUploadRanges[NumMerged - 1] : nullptr;
+            if (Last && Last->X + Last->Y >= Range.X)
+            {
+                const int32 End = FMath::Max(Last->X + Last->Y, Range.X + Range.Y);
+                NumRangeCells += End - (Last->X + Last->Y);
+                Last->Y = End - Last->X;
+            }
+            else
+            {
+                PendingUploadRanges[NumMerged++] = Range;
+                NumRangeCells += Range.Y;
+            }
+        }
+        PendingUploadRanges.SetNum(NumMerged, EAllowShrinking::No);
+
+        // Past the partial budget the packing and copies cost more than sending the grid
+        if (NumRangeCells > MaxFraction * Count)
+        {
+            PendingUploadRanges.Reset();
+        }
+    }
+    PendingUpload = Grid;
+    PendingUploadCount = Count;
+}
+
+int64 FNDIWindFieldBuffer::GetPendingUploadBytes() const
+{
+    if (!PendingUpload)
+    {
+        return 0;
+    }
+
+    int64 NumCells = PendingUploadRanges.Num() > 0 ? 0 : PendingUploadCount;
+    for (const FIntPoint& Range : PendingUploadRanges)
+    {
+        NumCells += Range.Y;
+    }
+    return NumCells * sizeof(FVector4f);
+}
+
 void FNDIWindFieldBuffer::InitRHI(FRHICommandListBase& RHICmdList)
 {
     // Prevent double initialization
@@ -520,6 +945,7 @@ void FNDIWindFieldBuffer::InitRHI(FRHICommandListBase& RHICmdList)
     // Release any stale resources first
     VelocityGridBufferRHI.SafeRelease();
     VelocityGridSRV.SafeRelease();
+    VelocityGridPooledBuffer.SafeRelease();
 
     if (NumElements <= 0)
     {
@@ -528,10 +954,10 @@ void FNDIWindFieldBuffer::InitRHI(FRHICommandListBase& RHICmdList)
     }
 
     const uint32 Stride = sizeof(FVector4f);
-    const uint32 BufferSize = NumElements * Stride;
 
-    FRHIResourceCreateInfo CreateInfo(TEXT("WindField.VelocityGrid"));
-    VelocityGridBufferRHI = RHICmdList.CreateStructuredBuffer(Stride, BufferSize, BUF_ShaderResource | BUF_StructuredBuffer | BUF_Static, CreateInfo);
+    // Pooled so PreStage can register it with the graph and upload through it
+    VelocityGridPooledBuffer = AllocatePooledBuffer(FRDGBufferDesc::CreateStructuredDesc(Stride, NumElements), TEXT("WindField.VelocityGrid"));
+    VelocityGridBufferRHI = VelocityGridPooledBuffer.IsValid() ? VelocityGridPooledBuffer->GetRHI() : nullptr;
 
     if (!VelocityGridBufferRHI.IsValid())
     {
@@ -550,6 +976,7 @@ void FNDIWindFieldBuffer::InitRHI(FRHICommandListBase& RHICmdList)
     {
         UE_LOG(LogTemp, Error, TEXT("[WindField::InitRHI] Failed to create SRV for buffer!"));
         VelocityGridBufferRHI.SafeRelease();
+        VelocityGridPooledBuffer.SafeRelease();
         return;
     }
 
@@ -575,6 +1002,7 @@ void FNDIWindFieldBuffer::ReleaseRHI()
 
     VelocityGridBufferRHI.SafeRelease();
     VelocityGridSRV.SafeRelease();
+    VelocityGridPooledBuffer.SafeRelease();
     bIsInitialized = false;
 }
 
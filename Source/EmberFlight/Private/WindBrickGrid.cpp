@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindBrickGrid.h"
+#include "Async/ParallelFor.h"
+
+void FWindBrickGrid::Reset()
+{
+    BrickLookup.Empty();
+    Slots.Empty();
+    ActiveBricks.Empty();
+    FreeSlots.Empty();
+    Front.Empty();
+    Back.Empty();
+}
+
+SIZE_T FWindBrickGrid::GetAllocatedSize() const
+{
+    const SIZE_T ChannelBytes = Front.X.GetAllocatedSize() + Front.Y.GetAllocatedSize() + Front.Z.GetAllocatedSize()
+        + Back.X.GetAllocatedSize() + Back.Y.GetAllocatedSize() + Back.Z.GetAllocatedSize();
+
+    return ChannelBytes + BrickLookup.GetAllocatedSize() + Slots.GetAllocatedSize()
+        + ActiveBricks.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+}
+
+FVector3f FWindBrickGrid::GetCell(const FIntVector& Cell) const
+{
+    const int32 Slot = FindSlot(GetBrickCoord(Cell));
+    if (Slot == INDEX_NONE)
+    {
+        return FVector3f::ZeroVector;
+    }
+    return Front.Get(Slot * BrickCells + GetLocalIndex(Cell.X, Cell.Y, Cell.Z));
+}
+
+FVector3f FWindBrickGrid::Sample(const FVector3f& CellPos) const
+{
+    if (ActiveBricks.Num() == 0)
+    {
+        return FVector3f::ZeroVector;
+    }
+
+    const int32 x0 = FMath::FloorToInt(CellPos.X);
+    const int32 y0 = FMath::FloorToInt(CellPos.Y);
+    const int32 z0 = FMath::FloorToInt(CellPos.Z);
+
+    FVector3f C[8];
+
+    // Most samples have all eight corners inside one brick, which costs a single lookup
+    const int32 LastLocal = BrickDim - 1;
+    if ((x0 & LastLocal) != LastLocal && (y0 & LastLocal) != LastLocal && (z0 & LastLocal) != LastLocal)
+    {
+        const int32 Slot = FindSlot(GetBrickCoord(FIntVector(x0, y0, z0)));
+        if (Slot == INDEX_NONE)
+        {
+            return FVector3f::ZeroVector;
+        }
+
+        const int32 Base = Slot * BrickCells + GetLocalIndex(x0, y0, z0);
+        const int32 DY = BrickDim;
+        const int32 DZ = BrickDim * BrickDim;
+        C[0] = Front.Get(Base);
+        C[1] = Front.Get(Base + 1);
+        C[2] = Front.Get(Base + DY);
+        C[3] = Front.Get(Base + DY + 1);
+        C[4] = Front.Get(Base + DZ);
+        C[5] = Front.Get(Base + DZ + 1);
+        C[6] = Front.Get(Base + DZ + DY);
+        C[7] = Front.Get(Base + DZ + DY + 1);
+    }
+    else
+    {
+        C[0] = GetCell(FIntVector(x0, y0, z0));
+        C[1] = GetCell(FIntVector(x0 + 1, y0, z0));
+        C[2] = GetCell(FIntVector(x0, y0 + 1, z0));
+        C[3] = GetCell(FIntVector(x0 + 1, y0 + 1, z0));
+        C[4] = GetCell(FIntVector(x0, y0, z0 + 1));
+        C[5] = GetCell(FIntVector(x0 + 1, y0, z0 + 1));
+        C[6] = GetCell(FIntVector(x0, y0 + 1, z0 + 1));
+        C[7] = GetCell(FIntVector(x0 + 1, y0 + 1, z0 + 1));
+    }
+
+    // Fractional distance within the cell
+    const float sx = CellPos.X - x0;
+    const float sy = CellPos.Y - y0;
+    const float sz = CellPos.Z - z0;
+
+    const FVector3f c00 = FMath::Lerp(C[0], C[1], sx);
+    const FVector3f c10 = FMath::Lerp(C[2], C[3], sx);
+    const FVector3f c01 = FMath::Lerp(C[4], C[5], sx);
+    const FVector3f c11 = FMath::Lerp(C[6], C[7], sx);
+    return FMath::Lerp(FMath::Lerp(c00, c10, sy), FMath::Lerp(c01, c11, sy), sz);
+}
+
+void FWindBrickGrid::Inject(const FVector3f& CellPos, const FVector3f& Velocity, float RadiusCells, int32 MaxBricks)
+{
+    if (RadiusCells <= 0.0f)
+    {
+        return;
+    }
+
+    const int32 MinX = FMath::FloorToInt(CellPos.X - RadiusCells);
+    const int32 MaxX = FMath::CeilToInt(CellPos.X + RadiusCells);
+    const int32 MinY = FMath::FloorToInt(CellPos.Y - RadiusCells);
+    const int32 MaxY = FMath::CeilToInt(CellPos.Y + RadiusCells);
+    const int32 MinZ = FMath::FloorToInt(CellPos.Z - RadiusCells);
+    const int32 MaxZ = FMath::CeilToInt(CellPos.Z + RadiusCells);
+
+    // Neighbouring cells mostly share a brick, so remember the last one instead of hashing every cell
+    FIntVector CachedBrick(MAX_int32);
+    int32 CachedSlot = INDEX_NONE;
+
+    for (int32 z = MinZ; z <= MaxZ; ++z)
+    {
+        for (int32 y = MinY; y <= MaxY; ++y)
+        {
+            for (int32 x = MinX; x <= MaxX; ++x)
+            {
+                // Same falloff as the dense grid, measured from the cell centre
+                const FVector3f CellCenter(x + 0.5f, y + 0.5f, z + 0.5f);
+                const float Dist = FVector3f::Dist(CellCenter, CellPos);
+                if (Dist > RadiusCells)
+                {
+                    continue;
+                }
+
+                const FIntVector BrickCoord = GetBrickCoord(FIntVector(x, y, z));
+                if (BrickCoord != CachedBrick)
+                {
+                    CachedBrick = BrickCoord;
+                    CachedSlot = FindSlot(BrickCoord);
+                    if (CachedSlot == INDEX_NONE)
+                    {
+                        CachedSlot = ActivateBrick(BrickCoord, MaxBricks);
+                    }
+                }
+
+                // Out of brick budget, the disturbance is dropped rather than growing without bound
+                if (CachedSlot == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const float Strength = 1.0f - (Dist / RadiusCells);
+                Front.Add(CachedSlot * BrickCells + GetLocalIndex(x, y, z), Velocity * Strength);
+            }
+        }
+    }
+}
+
+void FWindBrickGrid::Advect(float DeltaTime, float CellSize, float Decay, const FVector3f& Ambient, bool bParallel)
+{
+    if (Back.Num() != Front.Num())
+    {
+        Back.SetNumZeroed(Front.Num());
+    }
+
+    const float DeltaCells = DeltaTime / CellSize;
+
+    // Bricks only read the front buffer and write their own slot, so they are independent
+    ParallelFor(ActiveBricks.Num(), [this, DeltaCells, Decay, &Ambient](int32 ActiveIndex)
+    {
+        const int32 Slot = ActiveBricks[ActiveIndex];
+        FBrickInfo& Info = Slots[Slot];
+        const FIntVector Origin = Info.Coord * BrickDim;
+        const int32 Base = Slot * BrickCells;
+
+        float MaxSpeedSq = 0.0f;
+        float FaceMaxSpeedSq[6] = {};
+
+        for (int32 z = 0; z < BrickDim; ++z)
+        {
+            for (int32 y = 0; y < BrickDim; ++y)
+            {
+                for (int32 x = 0; x < BrickDim; ++x)
+                {
+                    const int32 Index = Base + GetLocalIndex(x, y, z);
+
+                    // The disturbance rides on the calm-air wind
+                    const FVector3f Wind = Front.Get(Index) + Ambient;
+                    const FVector3f Cell(Origin.X + x, Origin.Y + y, Origin.Z + z);
+                    const FVector3f Advected = Sample(Cell - Wind * DeltaCells) * Decay;
+                    Back.Set(Index, Advected);
+
+                    const float SpeedSq = Advected.SizeSquared();
+                    MaxSpeedSq = FMath::Max(MaxSpeedSq, SpeedSq);
+                    if (x == 0) FaceMaxSpeedSq[0] = FMath::Max(FaceMaxSpeedSq[0], SpeedSq);
+                    if (x == BrickDim - 1) FaceMaxSpeedSq[1] = FMath::Max(FaceMaxSpeedSq[1], SpeedSq);
+                    if (y == 0) FaceMaxSpeedSq[2] = FMath::Max(FaceMaxSpeedSq[2], SpeedSq);
+                    if (y == BrickDim - 1) FaceMaxSpeedSq[3] = FMath::Max(FaceMaxSpeedSq[3], SpeedSq);
+                    if (z == 0) FaceMaxSpeedSq[4] = FMath::Max(FaceMaxSpeedSq[4], SpeedSq);
+                    if (z == BrickDim - 1) FaceMaxSpeedSq[5] = FMath::Max(FaceMaxSpeedSq[5], SpeedSq);
+                }
+            }
+        }
+
+        Info.MaxSpeedSq = MaxSpeedSq;
+        FMemory::Memcpy(Info.FaceMaxSpeedSq, FaceMaxSpeedSq, sizeof(FaceMaxSpeedSq));
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void FWindBrickGrid::SwapAndUpdateActivity(float RetireSpeed, int32 RetireAfterSteps, int32 MaxBricks)
+{
+    Swap(Front, Back);
+
+    static const FIntVector FaceOffsets[6] =
+    {
+        FIntVector(-1, 0, 0), FIntVector(1, 0, 0),
+        FIntVector(0, -1, 0), FIntVector(0, 1, 0),
+        FIntVector(0, 0, -1), FIntVector(0, 0, 1)
+    };
+
+    const float RetireSpeedSq = RetireSpeed * RetireSpeed;
+    TArray<FIntVector, TInlineAllocator<64>> ToActivate;
+
+    for (int32 ActiveIndex = ActiveBricks.Num() - 1; ActiveIndex >= 0; --ActiveIndex)
+    {
+        const int32 Slot = ActiveBricks[ActiveIndex];
+        FBrickInfo& Info = Slots[Slot];
+
+        if (Info.MaxSpeedSq < RetireSpeedSq)
+        {
+            if (++Info.QuietSteps >= RetireAfterSteps)
+            {
+                ActiveBricks.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+                RetireBrick(Slot);
+            }
+            continue;
+        }
+        Info.QuietSteps = 0;
+
+        // Wind leaving through a face needs the neighbour to exist, or it would vanish at the brick border
+        for (int32 Face = 0; Face < 6; ++Face)
+        {
+            if (Info.FaceMaxSpeedSq[Face] >= RetireSpeedSq)
+            {
+                ToActivate.Add(Info.Coord + FaceOffsets[Face]);
+            }
+        }
+    }
+
+    for (const FIntVector& BrickCoord : ToActivate)
+    {
+        if (FindSlot(BrickCoord) == INDEX_NONE)
+        {
+            ActivateBrick(BrickCoord, MaxBricks);
+        }
+    }
+}
+
+int32 FWindBrickGrid::ActivateBrick(const FIntVector& BrickCoord, int32 MaxBricks)
+{
+    if (ActiveBricks.Num() >= MaxBricks)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = Slots.AddDefaulted();
+        Front.SetNumZeroed((Slot + 1) * BrickCells);
+        Back.SetNumZeroed((Slot + 1) * BrickCells);
+    }
+
+    // Recycled slots still hold the wind of the brick that lived there
+    const int32 Base = Slot * BrickCells;
+    FMemory::Memzero(&Front.X[Base], BrickCells * sizeof(float));
+    FMemory::Memzero(&Front.Y[Base], BrickCells * sizeof(float));
+    FMemory::Memzero(&Front.Z[Base], BrickCells * sizeof(float));
+
+    Slots[Slot] = FBrickInfo();
+    Slots[Slot].Coord = BrickCoord;
+    BrickLookup.Add(BrickCoord, Slot);
+    ActiveBricks.Add(Slot);
+
+    return Slot;
+}
+
+void FWindBrickGrid::RetireBrick(int32 Slot)
+{
+    BrickLookup.Remove(Slots[Slot].Coord);
+    FreeSlots.Add(Slot);
+}
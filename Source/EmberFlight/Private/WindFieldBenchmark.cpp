@@ -0,0 +1,328 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindVectorField.h"
+#include "NiagaraDataInterfaceWindField.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+
+namespace WindFieldBenchmark
+{
+    struct FLayoutTimings
+    {
+        double ScalarNs = 0.0;
+        double BatchNs = 0.0;
+        double StepMs = 0.0;
+    };
+
+    static FLayoutTimings RunLayout(EWindGridLayout Layout, int32 Size, TConstArrayView<FVector3f> Positions)
+    {
+        UWindVectorField* Field = NewObject<UWindVectorField>(GetTransientPackage(), NAME_None, RF_Transient);
+        Field->SizeX = Size;
+        Field->SizeY = Size;
+        Field->SizeZ = Size;
+        Field->GridLayout = Layout;
+        Field->Initialize();
+
+        FLayoutTimings Timings;
+
+        // Scalar path, one view validation and one trilinear gather per call
+        double Checksum = 0.0;
+        double StartTime = FPlatformTime::Seconds();
+        for (const FVector3f& Position : Positions)
+        {
+            Checksum += Field->SampleWindAtPosition(FVector(Position)).X;
+        }
+        Timings.ScalarNs = (FPlatformTime::Seconds() - StartTime) * 1e9 / Positions.Num();
+
+        TArray<FVector3f> Velocities;
+        Velocities.SetNumUninitialized(Positions.Num());
+        StartTime = FPlatformTime::Seconds();
+        Field->SampleWindBatch(Positions, Velocities);
+        Timings.BatchNs = (FPlatformTime::Seconds() - StartTime) * 1e9 / Positions.Num();
+
+        // The solver gathers the same trilinear corners, so it is timed alongside the sampling
+        StartTime = FPlatformTime::Seconds();
+        Field->Update(1.0f / 30.0f);
+        Field->WaitForAsyncUpdate();
+        Timings.StepMs = (FPlatformTime::Seconds() - StartTime) * 1e3;
+
+        UE_LOG(LogTemp, Verbose, TEXT("Wind benchmark checksum %f"), Checksum + Velocities[0].X);
+
+        Field->MarkAsGarbage();
+        return Timings;
+    }
+
+    // Wall time is used as the proxy for cache misses, hardware counters are not portable across our targets
+    static void Run(const TArray<FString>& Args)
+    {
+        const int32 Size = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 8, 512) : 128;
+        const int32 NumSamples = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100000;
+
+        // Fixed seed so both layouts see the same positions, spread over the whole grid like a particle system would be
+        FRandomStream Stream(1337);
+        const float Extent = (Size - 1) * GetDefault<UWindVectorField>()->CellSize;
+        TArray<FVector3f> Positions;
+        Positions.SetNumUninitialized(NumSamples);
+        for (FVector3f& Position : Positions)
+        {
+            Position = FVector3f(Stream.FRand(), Stream.FRand(), Stream.FRand()) * Extent;
+        }
+
+        const FLayoutTimings Linear = RunLayout(EWindGridLayout::Linear, Size, Positions);
+        const FLayoutTimings Tiled = RunLayout(EWindGridLayout::Tiled, Size, Positions);
+
+        UE_LOG(LogTemp, Log, TEXT("Wind layout benchmark, %d^3 grid, %d random samples"), Size, NumSamples);
+        UE_LOG(LogTemp, Log, TEXT("  Linear: scalar %.1f ns, batch %.1f ns, step %.2f ms"), Linear.ScalarNs, Linear.BatchNs, Linear.StepMs);
+        UE_LOG(LogTemp, Log, TEXT("  Tiled:  scalar %.1f ns, batch %.1f ns, step %.2f ms"), Tiled.ScalarNs, Tiled.BatchNs, Tiled.StepMs);
+        UE_LOG(LogTemp, Log, TEXT("  Speedup: scalar %.2fx, batch %.2fx, step %.2fx"),
+            Linear.ScalarNs / FMath::Max(Tiled.ScalarNs, UE_SMALL_NUMBER),
+            Linear.BatchNs / FMath::Max(Tiled.BatchNs, UE_SMALL_NUMBER),
+            Linear.StepMs / FMath::Max(Tiled.StepMs, UE_SMALL_NUMBER));
+    }
+
+    // Kinetic energy of the grid, weighted by cell volume so grids of different CellSize compare
+    static double ComputeEnergy(const UWindVectorField* Field)
+    {
+        const FWindGridView View = Field->GetGridView();
+        if (!View.IsValid())
+        {
+            return 0.0;
+        }
+
+        double Energy = 0.0;
+        for (int32 z = 0; z < View.SizeZ; ++z)
+        {
+            for (int32 y = 0; y < View.SizeY; ++y)
+            {
+                for (int32 x = 0; x < View.SizeX; ++x)
+                {
+                    Energy += View.GetCell(View.GetIndex(x, y, z)).SizeSquared();
+                }
+            }
+        }
+        return 0.5 * Energy * FMath::Cube(View.CellSize);
+    }
+
+    // Fraction of an injected gust's energy left after NumSteps, with no force field and no decay to blur the comparison
+    static double MeasureEnergyRetention(EWindAdvectionScheme Scheme, int32 Size, float CellSize, float GustRadius, int32 NumSteps)
+    {
+        UWindVectorField* Field = NewObject<UWindVectorField>(GetTransientPackage(), NAME_None, RF_Transient);
+        Field->SizeX = Size;
+        Field->SizeY = Size;
+        Field->SizeZ = Size;
+        Field->CellSize = CellSize;
+        Field->WindScale = 0.0f;
+        Field->AdvectionScheme = Scheme;
+        Field->Initialize();
+
+        const FVector Center(Size * CellSize * 0.5f);
+        Field->InjectWindAtPosition(Center - FVector(Size * CellSize * 0.25f, 0.0f, 0.0f), FVector(800.0f, 0.0f, 0.0f), GustRadius);
+        Field->InjectWindAtPosition(Center + FVector(0.0f, Size * CellSize * 0.25f, 0.0f), FVector(0.0f, -800.0f, 0.0f), GustRadius);
+
+        const double InitialEnergy = ComputeEnergy(Field);
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            // Decay is 1 - DeltaTime per step, cancelled out by dividing it back out of the energy below
+            Field->Update(1.0f / 30.0f);
+        }
+        Field->WaitForAsyncUpdate();
+        const double Decay = FMath::Pow(1.0 - 1.0 / 30.0, 2.0 * NumSteps);
+        const double FinalEnergy = ComputeEnergy(Field) / Decay;
+
+        Field->MarkAsGarbage();
+        return InitialEnergy > 0.0 ? FinalEnergy / InitialEnergy : 0.0;
+    }
+
+    static void RunAdvection(const TArray<FString>& Args)
+    {
+        const int32 Size = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 8, 256) : 64;
+        const int32 NumSteps = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 60;
+        const float CellSize = GetDefault<UWindVectorField>()->CellSize;
+        const float GustRadius = CellSize * 6.0f;
+
+        const double SemiLagrangian = MeasureEnergyRetention(EWindAdvectionScheme::SemiLagrangian, Size, CellSize, GustRadius, NumSteps);
+        const double MacCormack = MeasureEnergyRetention(EWindAdvectionScheme::MacCormack, Size, CellSize, GustRadius, NumSteps);
+        const double SemiLagrangianCoarse = MeasureEnergyRetention(EWindAdvectionScheme::SemiLagrangian, Size / 2, CellSize * 2.0f, GustRadius, NumSteps);
+        const double MacCormackCoarse = MeasureEnergyRetention(EWindAdvectionScheme::MacCormack, Size / 2, CellSize * 2.0f, GustRadius, NumSteps);
+
+        UE_LOG(LogTemp, Log, TEXT("Wind advection energy retention after %d steps (decay removed)"), NumSteps);
+        UE_LOG(LogTemp, Log, TEXT("  %d^3 x %.0f:  semi-Lagrangian %.3f, MacCormack %.3f"), Size, CellSize, SemiLagrangian, MacCormack);
+        UE_LOG(LogTemp, Log, TEXT("  %d^3 x %.0f:  semi-Lagrangian %.3f, MacCormack %.3f"), Size / 2, CellSize * 2.0f, SemiLagrangianCoarse, MacCormackCoarse);
+    }
+
+#if WITH_DEV_AUTOMATION_TESTS
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindAdvectionEnergyTest, "EmberFlight.WindField.AdvectionEnergyRetention",
+        EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+    // The point of MacCormack is a gust that survives longer, at the default cell size and at twice it
+    bool FWindAdvectionEnergyTest::RunTest(const FString& Parameters)
+    {
+        const int32 Size = 32;
+        const int32 NumSteps = 30;
+        const float CellSize = GetDefault<UWindVectorField>()->CellSize;
+        const float GustRadius = CellSize * 6.0f;
+
+        for (const float Scale : { 1.0f, 2.0f })
+        {
+            const double SemiLagrangian = MeasureEnergyRetention(EWindAdvectionScheme::SemiLagrangian, Size, CellSize * Scale, GustRadius, NumSteps);
+            const double MacCormack = MeasureEnergyRetention(EWindAdvectionScheme::MacCormack, Size, CellSize * Scale, GustRadius, NumSteps);
+
+            TestTrue(FString::Printf(TEXT("Semi-Lagrangian keeps some energy at %.0f"), CellSize * Scale), SemiLagrangian > 0.0);
+            TestTrue(FString::Printf(TEXT("MacCormack (%.3f) keeps more energy than semi-Lagrangian (%.3f) at %.0f"), MacCormack, SemiLagrangian, CellSize * Scale),
+                MacCormack > SemiLagrangian);
+        }
+        return true;
+    }
+
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindClipmapInjectionTest, "EmberFlight.WindField.ClipmapInjectionFrame",
+        EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+    // A gust injected into a static field has to show up at the same point in every clipmap level that holds it
+    bool FWindClipmapInjectionTest::RunTest(const FString& Parameters)
+    {
+        const int32 Size = 16;
+        const float CellSize = GetDefault<UWindVectorField>()->CellSize;
+        const FVector Gust(500.0f, 0.0f, 0.0f);
+
+        UWindVectorField* Field = NewObject<UWindVectorField>(GetTransientPackage(), NAME_None, RF_Transient);
+        Field->SizeX = Size;
+        Field->SizeY = Size;
+        Field->SizeZ = Size;
+        Field->WindScale = 0.0f;
+        Field->NumClipmapLevels = 2;
+        Field->bAsyncInitialize = false;
+        Field->Initialize();
+
+        // Moved after the levels exist, so they have to follow it
+        const FVector Origin(1000.0f, -700.0f, 300.0f);
+        Field->SetFieldOrigin(Origin);
+
+        if (!TestEqual(TEXT("Clipmap levels"), Field->GetNumClipmapLevels(), 2))
+        {
+            Field->MarkAsGarbage();
+            return false;
+        }
+
+        // The middle of level 0, well inside level 1 too
+        const FVector Point = Origin + FVector(Size * CellSize * 0.5f);
+        Field->InjectWindAtPosition(Point, Gust, CellSize * 4.0f);
+
+        for (int32 LevelIndex = 0; LevelIndex < Field->GetNumClipmapLevels(); ++LevelIndex)
+        {
+            const FVector Sample = Field->GetClipmapLevel(LevelIndex)->SampleWindAtPosition(Point);
+            TestTrue(FString::Printf(TEXT("Level %d sees the gust at the injection point (%.1f)"), LevelIndex, Sample.X), Sample.X > Gust.X * 0.25f);
+        }
+
+        Field->MarkAsGarbage();
+        return true;
+    }
+
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNDIWindFieldUploadRangesTest, "EmberFlight.WindField.PartialUploadRanges",
+        EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+    // An injection uploads its slices only, a scroll the whole grid, and pending uploads merge into one. Bytes are
+    // checked through GetPendingUploadBytes, the figure PreStage adds to the NDI Upload Bytes stat.
+    bool FNDIWindFieldUploadRangesTest::RunTest(const FString& Parameters)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+        UWindVectorField* Field = NewObject<UWindVectorField>(World, NAME_None, RF_Transient);
+        Field->SizeX = 16;
+        Field->SizeY = 16;
+        Field->SizeZ = 16;
+        Field->Initialize();
+
+        FNDIWindFieldGridInfo Info;
+        Info.Set(Field->GetGridView());
+        const int32 NumCells = Info.NumCells();
+        const int32 SliceCells = Info.Size.X * Info.Size.Y;
+        const int64 SliceBytes = SliceCells * sizeof(FVector4f);
+        const int64 FullBytes = NumCells * sizeof(FVector4f);
+        TArray<FVector4f> GridA, GridB;
+        GridA.SetNumZeroed(NumCells);
+        GridB.SetNumZeroed(NumCells);
+        TArray<FIntPoint> Ranges;
+
+        // Radius 1.5 cells around the middle of slice 8, slices 6 to 10 at most
+        const uint64 BeforeInjection = Field->GetGridVersion();
+        const FVector Center = FVector(8.5f) * Field->CellSize;
+        Field->InjectWindAtPosition(Field->FieldOrigin + Center, FVector(500.0f, 0.0f, 0.0f), Field->CellSize * 1.5f);
+        if (TestTrue(TEXT("An injection gives ranges"), FNDIWindFieldData::GatherUploadRanges(*Field, BeforeInjection, Info, NumCells, 0.5f, Ranges)))
+        {
+            TestEqual(TEXT("Adjacent slices merge into one range"), Ranges.Num(), 1);
+            if (Ranges.Num() == 1)
+            {
+                TestTrue(TEXT("The range starts at or after slice 6"), Ranges[0].X >= 6 * SliceCells);
+                TestTrue(TEXT("The range ends at or before slice 10"), Ranges[0].X + Ranges[0].Y <= 11 * SliceCells);
+                TestTrue(TEXT("The range covers the injected slice"), Ranges[0].X <= 8 * SliceCells && Ranges[0].X + Ranges[0].Y >= 9 * SliceCells);
+            }
+
+            FNDIWindFieldBuffer Buffer;
+            Buffer.QueueUpload(GridA.GetData(), NumCells, Ranges, 0.5f);
+            const int64 Bytes = Buffer.GetPendingUploadBytes();
+            TestTrue(FString::Printf(TEXT("An injection sends at most 5 slices (%lld bytes)"), Bytes), Bytes > 0 && Bytes <= 5 * SliceBytes);
+        }
+
+        // Moving the window shows every cell somewhere else
+        AActor* Target = World->SpawnActor<AActor>();
+        USceneComponent* Root = NewObject<USceneComponent>(Target);
+        Target->SetRootComponent(Root);
+        Root->RegisterComponent();
+        Target->SetActorLocation(FVector(3.5f, 3.5f, 3.5f) * Field->CellSize);
+        Field->bScrollWithTarget = true;
+        Field->SetScrollTarget(Target);
+
+        const uint64 BeforeScroll = Field->GetGridVersion();
+        Field->Update(1.0f / 30.0f);
+        Field->WaitForAsyncUpdate();
+        Ranges.Reset();
+        TestFalse(TEXT("A scroll uploads the whole grid"), FNDIWindFieldData::GatherUploadRanges(*Field, BeforeScroll, Info, NumCells, 0.5f, Ranges));
+        {
+            FNDIWindFieldBuffer Buffer;
+            Buffer.QueueUpload(GridA.GetData(), NumCells, Ranges, 0.5f);
+            TestEqual(TEXT("A scroll sends the whole grid"), Buffer.GetPendingUploadBytes(), FullBytes);
+        }
+
+        // Only the newest grid is uploaded, overlapping ranges of skipped frames are sent once
+        FNDIWindFieldBuffer Buffer;
+        Buffer.QueueUpload(GridA.GetData(), NumCells, { FIntPoint(0, SliceCells) }, 0.5f);
+        Buffer.QueueUpload(GridB.GetData(), NumCells, { FIntPoint(4 * SliceCells, 2 * SliceCells) }, 0.5f);
+        Buffer.QueueUpload(GridB.GetData(), NumCells, { FIntPoint(0, SliceCells), FIntPoint(5 * SliceCells, SliceCells) }, 0.5f);
+        TestTrue(TEXT("The newest grid is pending"), Buffer.PendingUpload == GridB.GetData());
+        TestEqual(TEXT("Pending ranges are merged"), Buffer.PendingUploadRanges.Num(), 2);
+        if (Buffer.PendingUploadRanges.Num() == 2)
+        {
+            TestTrue(TEXT("First range kept"), Buffer.PendingUploadRanges[0] == FIntPoint(0, SliceCells));
+            TestTrue(TEXT("Second range added"), Buffer.PendingUploadRanges[1] == FIntPoint(4 * SliceCells, 2 * SliceCells));
+        }
+        TestEqual(TEXT("Merged ranges send each slice once"), Buffer.GetPendingUploadBytes(), 3 * SliceBytes);
+
+        // Past the partial budget the pending upload becomes a full one
+        Buffer.QueueUpload(GridA.GetData(), NumCells, { FIntPoint(8 * SliceCells, 6 * SliceCells) }, 0.5f);
+        TestEqual(TEXT("Ranges over the budget upload everything"), Buffer.PendingUploadRanges.Num(), 0);
+        TestEqual(TEXT("Over the budget sends the whole grid"), Buffer.GetPendingUploadBytes(), FullBytes);
+
+        // A full upload absorbs everything, and stays full when ranges follow before it ran
+        Buffer.QueueUpload(GridB.GetData(), NumCells, { FIntPoint(0, SliceCells) }, 0.5f);
+        TestEqual(TEXT("Ranges after a pending full upload stay full"), Buffer.PendingUploadRanges.Num(), 0);
+        TestEqual(TEXT("Nothing is sent without a pending grid"), FNDIWindFieldBuffer().GetPendingUploadBytes(), (int64)0);
+
+        Field->MarkAsGarbage();
+        World->DestroyWorld(false);
+        return true;
+    }
+#endif
+
+    static FAutoConsoleCommand CompareAdvectionCommand(
+        TEXT("wind.CompareAdvection"),
+        TEXT("Injects two gusts and reports how much of their energy each advection scheme keeps, at CellSize and twice CellSize. Usage: wind.CompareAdvection [Size=64] [Steps=60]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunAdvection));
+
+    static FAutoConsoleCommand BenchmarkLayoutCommand(
+        TEXT("wind.BenchmarkLayout"),
+        TEXT("Times random-position wind sampling on a Linear and a Tiled grid. Usage: wind.BenchmarkLayout [Size=128] [Samples=100000]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
@@ -0,0 +1,376 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindGridView.h"
+
+FVector3f FWindGridView::SampleGrid(const FVector3f& GridPos) const
+{
+    switch (Precision)
+    {
+    case EWindVelocityPrecision::Half:  return SampleGridAs<EWindVelocityPrecision::Half>(GridPos);
+    case EWindVelocityPrecision::Int16: return SampleGridAs<EWindVelocityPrecision::Int16>(GridPos);
+    default:                            return SampleGridAs<EWindVelocityPrecision::Float32>(GridPos);
+    }
+}
+
+template<EWindVelocityPrecision P>
+FVector3f FWindGridView::SampleGridAs(const FVector3f& GridPos) const
+{
+    // GridPos components can be fractional
+    int x0 = FMath::FloorToInt(GridPos.X);
+    int y0 = FMath::FloorToInt(GridPos.Y);
+    int z0 = FMath::FloorToInt(GridPos.Z);
+
+    // Clamped indices are always in range, so the corners can be read without further checks
+    const int x1 = FMath::Clamp(x0 + 1, 0, SizeX - 1);
+    const int y1 = FMath::Clamp(y0 + 1, 0, SizeY - 1);
+    const int z1 = FMath::Clamp(z0 + 1, 0, SizeZ - 1);
+    x0 = FMath::Clamp(x0, 0, SizeX - 1);
+    y0 = FMath::Clamp(y0, 0, SizeY - 1);
+    z0 = FMath::Clamp(z0, 0, SizeZ - 1);
+
+    const int32 i000 = GetIndex(x0, y0, z0);
+    const int32 i100 = GetIndex(x1, y0, z0);
+    const int32 i010 = GetIndex(x0, y1, z0);
+    const int32 i110 = GetIndex(x1, y1, z0);
+    const int32 i001 = GetIndex(x0, y0, z1);
+    const int32 i101 = GetIndex(x1, y0, z1);
+    const int32 i011 = GetIndex(x0, y1, z1);
+    const int32 i111 = GetIndex(x1, y1, z1);
+
+    // Fractional distance within the cell
+    const float sx = GridPos.X - x0;
+    const float sy = GridPos.Y - y0;
+    const float sz = GridPos.Z - z0;
+
+    auto Trilerp = [&](const void* C)
+    {
+        const float c00 = FMath::Lerp(Load<P>(C, i000, DecodeScale), Load<P>(C, i100, DecodeScale), sx);
+        const float c10 = FMath::Lerp(Load<P>(C, i010, DecodeScale), Load<P>(C, i110, DecodeScale), sx);
+        const float c01 = FMath::Lerp(Load<P>(C, i001, DecodeScale), Load<P>(C, i101, DecodeScale), sx);
+        const float c11 = FMath::Lerp(Load<P>(C, i011, DecodeScale), Load<P>(C, i111, DecodeScale), sx);
+        return FMath::Lerp(FMath::Lerp(c00, c10, sy), FMath::Lerp(c01, c11, sy), sz);
+    };
+
+    const FVector3f Current(Trilerp(X), Trilerp(Y), Trilerp(Z));
+    if (!PrevX)
+    {
+        return Current;
+    }
+
+    // Trilinear weights are shared, so blending the two samples equals sampling the blended grid
+    const FVector3f Previous(Trilerp(PrevX), Trilerp(PrevY), Trilerp(PrevZ));
+    return FMath::Lerp(Previous, Current, Alpha);
+}
+
+void FWindGridView::GetCornerBounds(const FVector3f& GridPos, FVector3f& OutMin, FVector3f& OutMax) const
+{
+    // Same clamping as SampleGridAs
+    int x0 = FMath::FloorToInt(GridPos.X);
+    int y0 = FMath::FloorToInt(GridPos.Y);
+    int z0 = FMath::FloorToInt(GridPos.Z);
+    const int x1 = FMath::Clamp(x0 + 1, 0, SizeX - 1);
+    const int y1 = FMath::Clamp(y0 + 1, 0, SizeY - 1);
+    const int z1 = FMath::Clamp(z0 + 1, 0, SizeZ - 1);
+    x0 = FMath::Clamp(x0, 0, SizeX - 1);
+    y0 = FMath::Clamp(y0, 0, SizeY - 1);
+    z0 = FMath::Clamp(z0, 0, SizeZ - 1);
+
+    OutMin = OutMax = GetCell(GetIndex(x0, y0, z0));
+    for (const int32 Index : { GetIndex(x1, y0, z0), GetIndex(x0, y1, z0), GetIndex(x1, y1, z0),
+        GetIndex(x0, y0, z1), GetIndex(x1, y0, z1), GetIndex(x0, y1, z1), GetIndex(x1, y1, z1) })
+    {
+        const FVector3f Corner = GetCell(Index);
+        OutMin = OutMin.ComponentMin(Corner);
+        OutMax = OutMax.ComponentMax(Corner);
+    }
+}
+
+void FWindGridView::SampleBatch(TConstArrayView<FVector3f> Positions, TArrayView<FVector3f> OutVelocities) const
+{
+    check(OutVelocities.Num() >= Positions.Num());
+
+    const int32 NumPositions = Positions.Num();
+    if (!IsValid())
+    {
+        for (int32 i = 0; i < NumPositions; ++i)
+        {
+            OutVelocities[i] = FVector3f::ZeroVector;
+        }
+        return;
+    }
+
+    int32 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+    // Cell indices are built in float lanes, which is exact as long as they fit the 24 bit mantissa.
+    // Tiled storage is padded to whole tiles, its indices run past the logical cell count.
+    const bool bCanUseVectorPath = GetStorageCellCount(Layout, SizeX, SizeY, SizeZ) < (1 << 24);
+    if (bCanUseVectorPath)
+    {
+        for (; i + 4 <= NumPositions; i += 4)
+        {
+            switch (Precision)
+            {
+            case EWindVelocityPrecision::Half:  SampleFour<EWindVelocityPrecision::Half>(&Positions[i], &OutVelocities[i]); break;
+            case EWindVelocityPrecision::Int16: SampleFour<EWindVelocityPrecision::Int16>(&Positions[i], &OutVelocities[i]); break;
+            default:                            SampleFour<EWindVelocityPrecision::Float32>(&Positions[i], &OutVelocities[i]); break;
+            }
+        }
+    }
+#endif
+
+    // Scalar fallback for the remainder (or the whole batch without vector intrinsics)
+    for (; i < NumPositions; ++i)
+    {
+        OutVelocities[i] = SampleGrid(Positions[i] / CellSize - GridOffset);
+    }
+}
+
+void FWindGridView::DecodeRun(int32 Index, int32 Count, FVector4f* RESTRICT Dst) const
+{
+    // Float grids are a plain interleave, interpolated packed grids decode per cell
+    if (Precision == EWindVelocityPrecision::Float32)
+    {
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Dst[i] = FVector4f(GetCellAs<EWindVelocityPrecision::Float32>(Index + i), 0.0f);
+        }
+        return;
+    }
+
+    if (PrevX)
+    {
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Dst[i] = FVector4f(GetCell(Index + i), 0.0f);
+        }
+        return;
+    }
+
+    const void* Channels[3] = { X, Y, Z };
+    int32 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+    const VectorRegister4Float ScaleV = VectorSetFloat1(DecodeScale);
+    for (; i + 4 <= Count; i += 4)
+    {
+        alignas(16) float Lanes[3][4];
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (Precision == EWindVelocityPrecision::Half)
+            {
+                FPlatformMath::VectorLoadHalf(Lanes[Axis], static_cast<const uint16*>(Channels[Axis]) + Index + i);
+            }
+            else
+            {
+                const int16* Src = static_cast<const int16*>(Channels[Axis]) + Index + i;
+                const VectorRegister4Int Wide = MakeVectorRegisterInt(Src[0], Src[1], Src[2], Src[3]);
+                VectorStoreAligned(VectorMultiply(VectorIntToFloat(Wide), ScaleV), Lanes[Axis]);
+            }
+        }
+
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            Dst[i + Lane] = FVector4f(Lanes[0][Lane], Lanes[1][Lane], Lanes[2][Lane], 0.0f);
+        }
+    }
+#endif
+
+    for (; i < Count; ++i)
+    {
+        Dst[i] = FVector4f(GetCell(Index + i), 0.0f);
+    }
+}
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+// Fetches the eight corners of four lanes into lane-major float scratch, widening packed formats four lanes at a time
+template<EWindVelocityPrecision P>
+static FORCEINLINE void GatherCorners(const void* Channel, const int32 (&CornerIndex)[8][4], float Scale, float (&Out)[8][4])
+{
+    // There is no gather below AVX2, so corners are fetched per lane
+    if constexpr (P == EWindVelocityPrecision::Half)
+    {
+        const uint16* Src = static_cast<const uint16*>(Channel);
+        for (int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            alignas(16) uint16 Lanes[4];
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                Lanes[Lane] = Src[CornerIndex[Corner][Lane]];
+            }
+            FPlatformMath::VectorLoadHalf(Out[Corner], Lanes);
+        }
+    }
+    else if constexpr (P == EWindVelocityPrecision::Int16)
+    {
+        const int16* Src = static_cast<const int16*>(Channel);
+        const VectorRegister4Float ScaleV = VectorSetFloat1(Scale);
+        for (int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            const VectorRegister4Int Lanes = MakeVectorRegisterInt(
+                Src[CornerIndex[Corner][0]], Src[CornerIndex[Corner][1]], Src[CornerIndex[Corner][2]], Src[CornerIndex[Corner][3]]);
+            VectorStoreAligned(VectorMultiply(VectorIntToFloat(Lanes), ScaleV), Out[Corner]);
+        }
+    }
+    else
+    {
+        const float* Src = static_cast<const float*>(Channel);
+        for (int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                Out[Corner][Lane] = Src[CornerIndex[Corner][Lane]];
+            }
+        }
+    }
+}
+
+template<EWindVelocityPrecision P>
+void FWindGridView::SampleFour(const FVector3f* Positions, FVector3f* OutVelocities) const
+{
+    // Transpose the four AoS positions into component lanes
+    alignas(16) float PX[4], PY[4], PZ[4];
+    for (int32 Lane = 0; Lane < 4; ++Lane)
+    {
+        PX[Lane] = Positions[Lane].X;
+        PY[Lane] = Positions[Lane].Y;
+        PZ[Lane] = Positions[Lane].Z;
+    }
+
+    const VectorRegister4Float CellSizeV = VectorSetFloat1(CellSize);
+    const VectorRegister4Float GX = VectorSubtract(VectorDivide(VectorLoadAligned(PX), CellSizeV), VectorSetFloat1(GridOffset.X));
+    const VectorRegister4Float GY = VectorSubtract(VectorDivide(VectorLoadAligned(PY), CellSizeV), VectorSetFloat1(GridOffset.Y));
+    const VectorRegister4Float GZ = VectorSubtract(VectorDivide(VectorLoadAligned(PZ), CellSizeV), VectorSetFloat1(GridOffset.Z));
+
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float MaxX = VectorSetFloat1((float)(SizeX - 1));
+    const VectorRegister4Float MaxY = VectorSetFloat1((float)(SizeY - 1));
+    const VectorRegister4Float MaxZ = VectorSetFloat1((float)(SizeZ - 1));
+
+    auto ClampV = [&Zero](const VectorRegister4Float& V, const VectorRegister4Float& Max)
+    {
+        return VectorMin(VectorMax(V, Zero), Max);
+    };
+
+    // Same clamping as the scalar path, fractions are measured from the clamped lower corner
+    const VectorRegister4Float FloorX = VectorFloor(GX);
+    const VectorRegister4Float FloorY = VectorFloor(GY);
+    const VectorRegister4Float FloorZ = VectorFloor(GZ);
+
+    const VectorRegister4Float X0 = ClampV(FloorX, MaxX);
+    const VectorRegister4Float Y0 = ClampV(FloorY, MaxY);
+    const VectorRegister4Float Z0 = ClampV(FloorZ, MaxZ);
+    const VectorRegister4Float X1 = ClampV(VectorAdd(FloorX, One), MaxX);
+    const VectorRegister4Float Y1 = ClampV(VectorAdd(FloorY, One), MaxY);
+    const VectorRegister4Float Z1 = ClampV(VectorAdd(FloorZ, One), MaxZ);
+
+    const VectorRegister4Float SX = VectorSubtract(GX, X0);
+    const VectorRegister4Float SY = VectorSubtract(GY, Y0);
+    const VectorRegister4Float SZ = VectorSubtract(GZ, Z0);
+
+    // Rotate into ring buffer storage, coordinates are clamped so a single conditional subtract wraps them
+    const VectorRegister4Float SizeXV = VectorSetFloat1((float)SizeX);
+    const VectorRegister4Float SizeYV = VectorSetFloat1((float)SizeY);
+    const VectorRegister4Float SizeZV = VectorSetFloat1((float)SizeZ);
+    const VectorRegister4Float RingX = VectorSetFloat1((float)RingOffset.X);
+    const VectorRegister4Float RingY = VectorSetFloat1((float)RingOffset.Y);
+    const VectorRegister4Float RingZ = VectorSetFloat1((float)RingOffset.Z);
+
+    auto WrapV = [](const VectorRegister4Float& V, const VectorRegister4Float& Ring, const VectorRegister4Float& Size)
+    {
+        const VectorRegister4Float Shifted = VectorAdd(V, Ring);
+        return VectorSelect(VectorCompareGE(Shifted, Size), VectorSubtract(Shifted, Size), Shifted);
+    };
+
+    const VectorRegister4Float SX0 = WrapV(X0, RingX, SizeXV);
+    const VectorRegister4Float SX1 = WrapV(X1, RingX, SizeXV);
+    const VectorRegister4Float SY0 = WrapV(Y0, RingY, SizeYV);
+    const VectorRegister4Float SY1 = WrapV(Y1, RingY, SizeYV);
+    const VectorRegister4Float SZ0 = WrapV(Z0, RingZ, SizeZV);
+    const VectorRegister4Float SZ1 = WrapV(Z1, RingZ, SizeZV);
+
+    alignas(16) int32 CornerIndex[8][4];
+    if (Layout == EWindGridLayout::Linear)
+    {
+        // Linear cell indices of the eight corners
+        const VectorRegister4Float RowStride = VectorSetFloat1((float)SizeX);
+        const VectorRegister4Float SliceStride = VectorSetFloat1((float)(SizeX * SizeY));
+
+        const VectorRegister4Float Base00 = VectorMultiplyAdd(SZ0, SliceStride, VectorMultiply(SY0, RowStride));
+        const VectorRegister4Float Base10 = VectorMultiplyAdd(SZ0, SliceStride, VectorMultiply(SY1, RowStride));
+        const VectorRegister4Float Base01 = VectorMultiplyAdd(SZ1, SliceStride, VectorMultiply(SY0, RowStride));
+        const VectorRegister4Float Base11 = VectorMultiplyAdd(SZ1, SliceStride, VectorMultiply(SY1, RowStride));
+
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX0, Base00)), CornerIndex[0]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX1, Base00)), CornerIndex[1]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX0, Base10)), CornerIndex[2]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX1, Base10)), CornerIndex[3]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX0, Base01)), CornerIndex[4]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX1, Base01)), CornerIndex[5]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX0, Base11)), CornerIndex[6]);
+        VectorIntStore(VectorFloatToInt(VectorAdd(SX1, Base11)), CornerIndex[7]);
+    }
+    else
+    {
+        // Tile addressing is all shifts and masks, done per lane on the wrapped storage coordinates
+        alignas(16) int32 IX[2][4], IY[2][4], IZ[2][4];
+        VectorIntStore(VectorFloatToInt(SX0), IX[0]);
+        VectorIntStore(VectorFloatToInt(SX1), IX[1]);
+        VectorIntStore(VectorFloatToInt(SY0), IY[0]);
+        VectorIntStore(VectorFloatToInt(SY1), IY[1]);
+        VectorIntStore(VectorFloatToInt(SZ0), IZ[0]);
+        VectorIntStore(VectorFloatToInt(SZ1), IZ[1]);
+
+        for (int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            const int32 CX = Corner & 1;
+            const int32 CY = (Corner >> 1) & 1;
+            const int32 CZ = (Corner >> 2) & 1;
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                CornerIndex[Corner][Lane] = ComputeStorageIndex(Layout, IX[CX][Lane], IY[CY][Lane], IZ[CZ][Lane], SizeX, SizeY);
+            }
+        }
+    }
+
+    auto LerpV = [](const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& T)
+    {
+        return VectorMultiplyAdd(VectorSubtract(B, A), T, A);
+    };
+
+    auto SampleChannel = [&](const void* Channel)
+    {
+        alignas(16) float C[8][4];
+        GatherCorners<P>(Channel, CornerIndex, DecodeScale, C);
+
+        const VectorRegister4Float C00 = LerpV(VectorLoadAligned(C[0]), VectorLoadAligned(C[1]), SX);
+        const VectorRegister4Float C10 = LerpV(VectorLoadAligned(C[2]), VectorLoadAligned(C[3]), SX);
+        const VectorRegister4Float C01 = LerpV(VectorLoadAligned(C[4]), VectorLoadAligned(C[5]), SX);
+        const VectorRegister4Float C11 = LerpV(VectorLoadAligned(C[6]), VectorLoadAligned(C[7]), SX);
+        return LerpV(LerpV(C00, C10, SY), LerpV(C01, C11, SY), SZ);
+    };
+
+    VectorRegister4Float VX = SampleChannel(X);
+    VectorRegister4Float VY = SampleChannel(Y);
+    VectorRegister4Float VZ = SampleChannel(Z);
+
+    if (PrevX)
+    {
+        const VectorRegister4Float AlphaV = VectorSetFloat1(Alpha);
+        VX = LerpV(SampleChannel(PrevX), VX, AlphaV);
+        VY = LerpV(SampleChannel(PrevY), VY, AlphaV);
+        VZ = LerpV(SampleChannel(PrevZ), VZ, AlphaV);
+    }
+
+    alignas(16) float OX[4], OY[4], OZ[4];
+    VectorStoreAligned(VX, OX);
+    VectorStoreAligned(VY, OY);
+    VectorStoreAligned(VZ, OZ);
+
+    for (int32 Lane = 0; Lane < 4; ++Lane)
+    {
+        OutVelocities[Lane] = FVector3f(OX[Lane], OY[Lane], OZ[Lane]);
+    }
+}
+#endif
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindObstacleMask.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+
+// Cells per block edge of the coarse pass
+static constexpr int32 BakeBlockSize = 8;
+
+// Cell boxes are shrunk a little so geometry that only touches a face does not also fill the neighbouring cell
+static constexpr float BakeCellShrink = 0.98f;
+
+void FWindObstacleMask::Reset()
+{
+    Origin = FVector::ZeroVector;
+    Size = FIntVector::ZeroValue;
+    CellSize = 0.0f;
+    NumSolidCells = 0;
+    Bits.Empty();
+}
+
+bool FWindObstacleMask::IsSolidAt(const FVector& WorldPos) const
+{
+    if (!IsBaked())
+    {
+        return false;
+    }
+
+    const FVector CellPos = (WorldPos - Origin) / CellSize;
+    const int32 X = FMath::FloorToInt(CellPos.X);
+    const int32 Y = FMath::FloorToInt(CellPos.Y);
+    const int32 Z = FMath::FloorToInt(CellPos.Z);
+    if (X < 0 || Y < 0 || Z < 0 || X >= Size.X || Y >= Size.Y || Z >= Size.Z)
+    {
+        return false;
+    }
+
+    const int32 Index = X + (Y + Z * Size.Y) * Size.X;
+    return (Bits[Index >> 6] >> (Index & 63)) & 1;
+}
+
+void FWindObstacleMask::Bake(const UWorld* World, const FBox& Bounds, float InCellSize, ECollisionChannel ObjectType)
+{
+    Reset();
+    if (!World || !Bounds.IsValid || InCellSize <= 0.0f)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    Origin = Bounds.Min;
+    CellSize = InCellSize;
+    const FVector Extent = Bounds.GetSize() / CellSize;
+    Size = FIntVector(
+        FMath::Max(FMath::CeilToInt(Extent.X), 1),
+        FMath::Max(FMath::CeilToInt(Extent.Y), 1),
+        FMath::Max(FMath::CeilToInt(Extent.Z), 1));
+    Bits.SetNumZeroed((Size.X * Size.Y * Size.Z + 63) / 64);
+
+    const FCollisionQueryParams Params(SCENE_QUERY_STAT(WindObstacleBake), false);
+    const FCollisionObjectQueryParams ObjectParams(ObjectType);
+    auto Overlaps = [&](const FIntVector& Min, const FIntVector& Max)
+    {
+        const FVector BoxMin = Origin + FVector(Min) * CellSize;
+        const FVector BoxMax = Origin + FVector(Max) * CellSize;
+        const FVector HalfExtent = (BoxMax - BoxMin) * 0.5f * BakeCellShrink;
+        return World->OverlapAnyTestByObjectType((BoxMin + BoxMax) * 0.5f, FQuat::Identity, ObjectParams,
+            FCollisionShape::MakeBox(HalfExtent), Params);
+    };
+
+    int32 NumBlockTests = 0;
+    int32 NumCellTests = 0;
+    for (int32 bz = 0; bz < Size.Z; bz += BakeBlockSize)
+    {
+        for (int32 by = 0; by < Size.Y; by += BakeBlockSize)
+        {
+            for (int32 bx = 0; bx < Size.X; bx += BakeBlockSize)
+            {
+                // Most of a level is open air, one query clears a whole block of it
+                const FIntVector BlockMin(bx, by, bz);
+                const FIntVector BlockMax(FMath::Min(bx + BakeBlockSize, Size.X), FMath::Min(by + BakeBlockSize, Size.Y), FMath::Min(bz + BakeBlockSize, Size.Z));
+                ++NumBlockTests;
+                if (!Overlaps(BlockMin, BlockMax))
+                {
+                    continue;
+                }
+
+                for (int32 z = BlockMin.Z; z < BlockMax.Z; ++z)
+                {
+                    for (int32 y = BlockMin.Y; y < BlockMax.Y; ++y)
+                    {
+                        for (int32 x = BlockMin.X; x < BlockMax.X; ++x)
+                        {
+                            ++NumCellTests;
+                            if (Overlaps(FIntVector(x, y, z), FIntVector(x + 1, y + 1, z + 1)))
+                            {
+                                const int32 Index = x + (y + z * Size.Y) * Size.X;
+                                Bits[Index >> 6] |= uint64(1) << (Index & 63);
+                                ++NumSolidCells;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Baked wind obstacle mask %dx%dx%d: %d solid cells, %d block and %d cell overlaps in %.2f s"),
+        Size.X, Size.Y, Size.Z, NumSolidCells, NumBlockTests, NumCellTests, FPlatformTime::Seconds() - StartTime);
+}
@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindPressureSolver.h"
+#include "Async/ParallelFor.h"
+
+// V(2,2) cycles, the coarsest level is small enough to just sweep until it has settled
+static constexpr int32 PreSmoothSweeps = 2;
+static constexpr int32 PostSmoothSweeps = 2;
+static constexpr int32 CoarsestSweeps = 16;
+static constexpr int32 MaxLevels = 10;
+
+// Below this many cells a level is cheaper to walk on one thread than to fan out
+static constexpr int32 MinParallelCells = 4096;
+
+static EParallelForFlags GetLevelFlags(int32 NumCells, bool bParallel)
+{
+    return bParallel && NumCells >= MinParallelCells ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+}
+
+void FWindPressureSolver::Resize(const FIntVector& InSize)
+{
+    if (GetSize() == InSize)
+    {
+        return;
+    }
+
+    Levels.Reset();
+
+    // Halve (rounding up) until a level is too small to coarsen further
+    FIntVector LevelSize = InSize;
+    for (int32 LevelIndex = 0; LevelIndex < MaxLevels; ++LevelIndex)
+    {
+        FLevel& Level = Levels.AddDefaulted_GetRef();
+        Level.Size = LevelSize;
+        Level.StencilScale = (float)(1 << LevelIndex);
+        Level.Pressure.SetNumZeroed(Level.Num());
+        Level.Rhs.SetNumZeroed(Level.Num());
+        Level.Residual.SetNumZeroed(Level.Num());
+
+        const FIntVector NextSize((LevelSize.X + 1) / 2, (LevelSize.Y + 1) / 2, (LevelSize.Z + 1) / 2);
+        if (LevelSize.GetMin() <= 2 || NextSize == LevelSize)
+        {
+            break;
+        }
+        LevelSize = NextSize;
+    }
+}
+
+void FWindPressureSolver::Reset()
+{
+    Levels.Empty();
+}
+
+SIZE_T FWindPressureSolver::GetAllocatedSize() const
+{
+    SIZE_T Bytes = Levels.GetAllocatedSize();
+    for (const FLevel& Level : Levels)
+    {
+        Bytes += Level.Pressure.GetAllocatedSize() + Level.Rhs.GetAllocatedSize() + Level.Residual.GetAllocatedSize();
+    }
+    return Bytes;
+}
+
+int32 FWindPressureSolver::Solve(double BudgetSeconds, int32 MaxCycles, bool bParallel)
+{
+    if (Levels.Num() == 0)
+    {
+        return 0;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumCycles = 0;
+    do
+    {
+        const double CycleStartTime = FPlatformTime::Seconds();
+        VCycle(0, bParallel);
+        ++NumCycles;
+
+        // Stop before the next cycle, assuming it takes as long as this one
+        const double Now = FPlatformTime::Seconds();
+        if ((Now - StartTime) + (Now - CycleStartTime) > BudgetSeconds)
+        {
+            break;
+        }
+    }
+    while (NumCycles < MaxCycles);
+
+    return NumCycles;
+}
+
+void FWindPressureSolver::VCycle(int32 LevelIndex, bool bParallel)
+{
+    FLevel& Level = Levels[LevelIndex];
+    if (LevelIndex == Levels.Num() - 1)
+    {
+        Smooth(Level, CoarsestSweeps, bParallel);
+        return;
+    }
+
+    Smooth(Level, PreSmoothSweeps, bParallel);
+    ComputeResidual(Level, bParallel);
+
+    // The coarse level solves for the correction of the residual, starting from zero
+    FLevel& Coarse = Levels[LevelIndex + 1];
+    Restrict(Level, Coarse, bParallel);
+    FMemory::Memzero(Coarse.Pressure.GetData(), Coarse.Pressure.Num() * sizeof(float));
+    VCycle(LevelIndex + 1, bParallel);
+
+    Prolongate(Coarse, Level, bParallel);
+    Smooth(Level, PostSmoothSweeps, bParallel);
+}
+
+void FWindPressureSolver::Smooth(FLevel& Level, int32 NumSweeps, bool bParallel)
+{
+    const FIntVector Size = Level.Size;
+    const int32 SliceStride = Size.X * Size.Y;
+    const float StencilScale = Level.StencilScale;
+    float* RESTRICT P = Level.Pressure.GetData();
+    const float* RESTRICT B = Level.Rhs.GetData();
+
+    for (int32 Sweep = 0; Sweep < NumSweeps; ++Sweep)
+    {
+        // Cells of one colour only have neighbours of the other, so a colour can be updated in place from any thread
+        for (int32 Color = 0; Color < 2; ++Color)
+        {
+            ParallelFor(Size.Z, [&, Color](int32 z)
+            {
+                for (int32 y = 0; y < Size.Y; ++y)
+                {
+                    int32 Index = Level.GetIndex((Color + y + z) & 1, y, z);
+                    for (int32 x = (Color + y + z) & 1; x < Size.X; x += 2, Index += 2)
+                    {
+                        // Pressure is zero outside the grid, wind leaves through the open window faces
+                        const float Sum = (x > 0 ? P[Index - 1] : 0.0f) + (x < Size.X - 1 ? P[Index + 1] : 0.0f)
+                            + (y > 0 ? P[Index - Size.X] : 0.0f) + (y < Size.Y - 1 ? P[Index + Size.X] : 0.0f)
+                            + (z > 0 ? P[Index - SliceStride] : 0.0f) + (z < Size.Z - 1 ? P[Index + SliceStride] : 0.0f);
+                        P[Index] = (Sum - StencilScale * B[Index]) * (1.0f / 6.0f);
+                    }
+                }
+            }, GetLevelFlags(Level.Num(), bParallel));
+        }
+    }
+}
+
+void FWindPressureSolver::ComputeResidual(FLevel& Level, bool bParallel)
+{
+    const FIntVector Size = Level.Size;
+    const int32 SliceStride = Size.X * Size.Y;
+    const float InvStencilScale = 1.0f / Level.StencilScale;
+    const float* RESTRICT P = Level.Pressure.GetData();
+    const float* RESTRICT B = Level.Rhs.GetData();
+    float* RESTRICT R = Level.Residual.GetData();
+
+    ParallelFor(Size.Z, [&](int32 z)
+    {
+        for (int32 y = 0; y < Size.Y; ++y)
+        {
+            int32 Index = Level.GetIndex(0, y, z);
+            for (int32 x = 0; x < Size.X; ++x, ++Index)
+            {
+                const float Sum = (x > 0 ? P[Index - 1] : 0.0f) + (x < Size.X - 1 ? P[Index + 1] : 0.0f)
+                    + (y > 0 ? P[Index - Size.X] : 0.0f) + (y < Size.Y - 1 ? P[Index + Size.X] : 0.0f)
+                    + (z > 0 ? P[Index - SliceStride] : 0.0f) + (z < Size.Z - 1 ? P[Index + SliceStride] : 0.0f);
+                R[Index] = B[Index] - (Sum - 6.0f * P[Index]) * InvStencilScale;
+            }
+        }
+    }, GetLevelFlags(Level.Num(), bParallel));
+}
+
+void FWindPressureSolver::Restrict(const FLevel& Fine, FLevel& Coarse, bool bParallel)
+{
+    const float* RESTRICT R = Fine.Residual.GetData();
+    float* RESTRICT B = Coarse.Rhs.GetData();
+
+    // Average of the (up to eight) fine cells covered by each coarse cell
+    ParallelFor(Coarse.Size.Z, [&](int32 z)
+    {
+        for (int32 y = 0; y < Coarse.Size.Y; ++y)
+        {
+            for (int32 x = 0; x < Coarse.Size.X; ++x)
+            {
+                float Sum = 0.0f;
+                int32 Count = 0;
+                for (int32 fz = 2 * z; fz < FMath::Min(2 * z + 2, Fine.Size.Z); ++fz)
+                {
+                    for (int32 fy = 2 * y; fy < FMath::Min(2 * y + 2, Fine.Size.Y); ++fy)
+                    {
+                        for (int32 fx = 2 * x; fx < FMath::Min(2 * x + 2, Fine.Size.X); ++fx)
+                        {
+                            Sum += R[Fine.GetIndex(fx, fy, fz)];
+                            ++Count;
+                        }
+                    }
+                }
+                B[Coarse.GetIndex(x, y, z)] = Sum / Count;
+            }
+        }
+    }, GetLevelFlags(Coarse.Num(), bParallel));
+}
+
+void FWindPressureSolver::Prolongate(const FLevel& Coarse, FLevel& Fine, bool bParallel)
+{
+    const float* RESTRICT E = Coarse.Pressure.GetData();
+    float* RESTRICT P = Fine.Pressure.GetData();
+
+    // Piecewise constant, the post-smoothing sweeps take out the steps this leaves between coarse cells
+    ParallelFor(Fine.Size.Z, [&](int32 z)
+    {
+        for (int32 y = 0; y < Fine.Size.Y; ++y)
+        {
+            int32 Index = Fine.GetIndex(0, y, z);
+            const int32 CoarseRow = Coarse.GetIndex(0, y >> 1, z >> 1);
+            for (int32 x = 0; x < Fine.Size.X; ++x, ++Index)
+            {
+                P[Index] += E[CoarseRow + (x >> 1)];
+            }
+        }
+    }, GetLevelFlags(Fine.Num(), bParallel));
+}
@@ -0,0 +1,499 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindSequence.h"
+#include "WindVectorField.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopedSlowTask.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sequence Decode"), STAT_WindField_SequenceDecode, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sequence Frames Decoded"), STAT_WindField_SequenceFramesDecoded, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sequence Stalls"), STAT_WindField_SequenceStalls, STATGROUP_WindField);
+DECLARE_MEMORY_STAT(TEXT("Sequence Memory"), STAT_WindField_SequenceMemory, STATGROUP_WindField);
+
+// Uncompressed frame size per cell, a low and a high byte plane for each of the three channels
+static constexpr int32 FrameBytesPerCell = 6;
+
+void UWindSequence::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    int32 NumFrames = Frames.Num();
+    Ar << NumFrames;
+    if (Ar.IsLoading())
+    {
+        Frames.Empty(NumFrames);
+        for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+        {
+            Frames.Add(new FByteBulkData());
+        }
+        RecordBase.Empty();
+    }
+
+    for (FByteBulkData& Frame : Frames)
+    {
+        Frame.Serialize(Ar, this);
+    }
+}
+
+bool UWindSequence::RecordFrame(const UWindVectorField* Field)
+{
+    const FWindGridView View = Field ? Field->GetGridView() : FWindGridView();
+    if (!View.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RecordFrame: %s has no dense grid to record"), *GetNameSafe(Field));
+        return false;
+    }
+
+    const FIntVector ViewSize(View.SizeX, View.SizeY, View.SizeZ);
+    if (Frames.Num() == 0)
+    {
+        GridSize = ViewSize;
+        CellSize = View.CellSize;
+        GridOffset = View.GridOffset;
+        RecordedKeyframeInterval = FMath::Max(KeyframeInterval, 1);
+        RecordedMaxSpeed = QuantizationMaxSpeed;
+        CompressedBytes = 0;
+    }
+    else if (ViewSize != GridSize || View.CellSize != CellSize || View.GridOffset != GridOffset)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RecordFrame: the grid of %s moved or changed size since the first frame of %s"), *GetNameSafe(Field), *GetNameSafe(this));
+        return false;
+    }
+    else if (RecordBase.Num() != GetNumCells() && !RestoreRecordBase())
+    {
+        return false;
+    }
+
+    const int32 NumCells = GetNumCells();
+    FWindPackedChannels Quantized;
+    Quantized.Configure(EWindVelocityPrecision::Int16, RecordedMaxSpeed);
+    Quantized.SetNumZeroed(NumCells);
+    for (int32 z = 0; z < View.SizeZ; ++z)
+    {
+        for (int32 y = 0; y < View.SizeY; ++y)
+        {
+            int32 WindowIndex = (y + z * View.SizeY) * View.SizeX;
+            for (int32 x = 0; x < View.SizeX; ++x, ++WindowIndex)
+            {
+                Quantized.Set(WindowIndex, View.GetCell(View.GetIndex(x, y, z)));
+            }
+        }
+    }
+
+    // Calm regions give deltas of a few steps either side of zero, splitting the bytes into planes leaves the
+    // high plane almost all 0x00 and 0xFF, which zlib packs far better than interleaved words
+    const bool bKeyframe = IsKeyframe(Frames.Num());
+    TArray<uint8> Planes;
+    Planes.SetNumUninitialized(NumCells * FrameBytesPerCell);
+    const uint16* Current[3] = { Quantized.X.GetData(), Quantized.Y.GetData(), Quantized.Z.GetData() };
+    const uint16* Base[3] = { RecordBase.X.GetData(), RecordBase.Y.GetData(), RecordBase.Z.GetData() };
+    for (int32 Channel = 0; Channel < 3; ++Channel)
+    {
+        uint8* RESTRICT Low = Planes.GetData() + Channel * 2 * NumCells;
+        uint8* RESTRICT High = Low + NumCells;
+        for (int32 Index = 0; Index < NumCells; ++Index)
+        {
+            const uint16 Value = bKeyframe ? Current[Channel][Index] : (uint16)(Current[Channel][Index] - Base[Channel][Index]);
+            Low[Index] = (uint8)(Value & 0xFF);
+            High[Index] = (uint8)(Value >> 8);
+        }
+    }
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Planes.Num());
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Planes.GetData(), Planes.Num()))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RecordFrame: failed to compress frame %d of %s"), Frames.Num(), *GetNameSafe(this));
+        return false;
+    }
+
+    // Kept out of the export, loading the asset reads none of the frames until a player asks for them
+    FByteBulkData* Frame = new FByteBulkData();
+    Frame->SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+    Frame->Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(Frame->Realloc(CompressedSize), Compressed.GetData(), CompressedSize);
+    Frame->Unlock();
+    Frames.Add(Frame);
+
+    CompressedBytes += CompressedSize;
+    RecordBase = MoveTemp(Quantized);
+    MarkPackageDirty();
+    return true;
+}
+
+bool UWindSequence::RestoreRecordBase()
+{
+    TArray<uint8> Scratch;
+    const int32 LastFrame = Frames.Num() - 1;
+    for (int32 FrameIndex = LastFrame - LastFrame % GetKeyframeInterval(); FrameIndex <= LastFrame; ++FrameIndex)
+    {
+        if (!DecodeFrame(FrameIndex, RecordBase, Scratch))
+        {
+            RecordBase.Empty();
+            return false;
+        }
+    }
+    return true;
+}
+
+void UWindSequence::ClearFrames()
+{
+    Frames.Empty();
+    RecordBase.Empty();
+    GridSize = FIntVector::ZeroValue;
+    CellSize = 0.0f;
+    GridOffset = FVector3f::ZeroVector;
+    RecordedKeyframeInterval = 0;
+    RecordedMaxSpeed = 0.0f;
+    CompressedBytes = 0;
+    MarkPackageDirty();
+}
+
+bool UWindSequence::DecodeFrame(int32 FrameIndex, FWindPackedChannels& Channels, TArray<uint8>& Scratch)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_SequenceDecode);
+
+    const int32 NumCells = GetNumCells();
+    const bool bKeyframe = IsKeyframe(FrameIndex);
+    if (!Frames.IsValidIndex(FrameIndex) || NumCells <= 0 || (!bKeyframe && Channels.Num() != NumCells))
+    {
+        return false;
+    }
+
+    // Reads straight from the package when the payload is not resident. A resident copy (a recording that was not
+    // saved yet) is left in place, it may be the only one.
+    FByteBulkData& Frame = Frames[FrameIndex];
+    const int32 CompressedSize = (int32)Frame.GetBulkDataSize();
+    Scratch.SetNumUninitialized(CompressedSize + NumCells * FrameBytesPerCell, EAllowShrinking::No);
+    void* Compressed = Scratch.GetData();
+    Frame.GetCopy(&Compressed, false);
+
+    const uint8* Planes = Scratch.GetData() + CompressedSize;
+    if (!FCompression::UncompressMemory(NAME_Zlib, Scratch.GetData() + CompressedSize, NumCells * FrameBytesPerCell, Compressed, CompressedSize))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DecodeFrame: frame %d of %s is corrupt"), FrameIndex, *GetNameSafe(this));
+        return false;
+    }
+
+    if (bKeyframe)
+    {
+        Channels.Configure(EWindVelocityPrecision::Int16, RecordedMaxSpeed);
+        if (Channels.Num() != NumCells)
+        {
+            Channels.SetNumZeroed(NumCells);
+        }
+    }
+
+    uint16* Target[3] = { Channels.X.GetData(), Channels.Y.GetData(), Channels.Z.GetData() };
+    for (int32 Channel = 0; Channel < 3; ++Channel)
+    {
+        const uint8* RESTRICT Low = Planes + Channel * 2 * NumCells;
+        const uint8* RESTRICT High = Low + NumCells;
+        uint16* RESTRICT Dst = Target[Channel];
+        for (int32 Index = 0; Index < NumCells; ++Index)
+        {
+            const uint16 Value = (uint16)(Low[Index] | (High[Index] << 8));
+            Dst[Index] = bKeyframe ? Value : (uint16)(Dst[Index] + Value);
+        }
+    }
+
+    INC_DWORD_STAT(STAT_WindField_SequenceFramesDecoded);
+    return true;
+}
+
+#if WITH_EDITOR
+void UWindSequence::RecordFromSourceField()
+{
+    if (!SourceField)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RecordFromSourceField: %s has no SourceField"), *GetNameSafe(this));
+        return;
+    }
+
+    // A scratch field with the source as its template copies every setting, stepped once per frame in sync
+    UWindVectorField* Recorder = NewObject<UWindVectorField>(GetTransientPackage(), NAME_None, RF_Transient, SourceField);
+    Recorder->NumClipmapLevels = 1;
+    Recorder->bScrollWithTarget = false;
+    Recorder->bAsyncSimulation = false;
+    Recorder->bFixedTimestep = false;
+    Recorder->Initialize();
+
+    // One more frame than the duration covers, so the last one lands on RecordDuration
+    const int32 NumFramesToRecord = FMath::CeilToInt(RecordDuration * FrameRate) + 1;
+    FScopedSlowTask SlowTask((float)NumFramesToRecord, FText::FromString(FString::Printf(TEXT("Recording wind sequence %s"), *GetName())));
+    SlowTask.MakeDialog(true);
+
+    Modify();
+    ClearFrames();
+    for (int32 FrameIndex = 0; FrameIndex < NumFramesToRecord && !SlowTask.ShouldCancel(); ++FrameIndex)
+    {
+        SlowTask.EnterProgressFrame();
+        if (FrameIndex > 0)
+        {
+            Recorder->Update(1.0f / FrameRate);
+        }
+        if (!RecordFrame(Recorder))
+        {
+            break;
+        }
+    }
+    Recorder->MarkAsGarbage();
+
+    UE_LOG(LogTemp, Log, TEXT("Recorded %d wind frames of %s into %s, %lld bytes"), Frames.Num(), *GetNameSafe(SourceField), *GetNameSafe(this), CompressedBytes);
+}
+#endif
+
+void FWindSequencePlayer::Start(UWindSequence* InSequence, float StartTime, int32 ReadAheadFrames, bool bInLoop)
+{
+    Stop();
+    if (!InSequence || InSequence->GetNumFrames() == 0)
+    {
+        return;
+    }
+
+    Sequence = InSequence;
+    Time = FMath::Max(StartTime, 0.0f);
+    bLoop = bInLoop;
+
+    // The two frames on display plus the read-ahead, and two more for the pair shown before them
+    WindowFrames = FMath::Min(FMath::Max(ReadAheadFrames, 0) + 2, Sequence->GetNumFrames());
+    Slots.SetNum(WindowFrames + 2);
+
+    Advance(0.0f);
+}
+
+void FWindSequencePlayer::Stop()
+{
+    DecodeTask.Wait();
+    DecodeTask = UE::Tasks::FTask();
+    DecodeRequestsInFlight.Reset();
+    bDecodeFailed = false;
+
+    Sequence = nullptr;
+    Time = 0.0f;
+    Slots.Empty();
+    DisplaySlotA = INDEX_NONE;
+    DisplaySlotB = INDEX_NONE;
+    PreviousSlotA = INDEX_NONE;
+    PreviousSlotB = INDEX_NONE;
+    DisplayAlpha = 0.0f;
+    bHasFrames.store(false, std::memory_order_release);
+
+    DecoderState.Empty();
+    DecoderFrame = INDEX_NONE;
+    DecoderScratch.Empty();
+    SET_MEMORY_STAT(STAT_WindField_SequenceMemory, 0);
+}
+
+bool FWindSequencePlayer::Advance(float DeltaTime)
+{
+    if (!Sequence)
+    {
+        return false;
+    }
+
+    // The task owns its requests and the slots they name until it completes, it is never waited on here
+    if (DecodeRequestsInFlight.Num() > 0 && DecodeTask.IsCompleted())
+    {
+        for (const FDecodeRequest& Request : DecodeRequestsInFlight)
+        {
+            Slots[Request.Slot].Frame = Request.Frame;
+        }
+        DecodeRequestsInFlight.Reset();
+
+        if (bDecodeFailed)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Wind sequence %s failed to decode, playback stopped"), *GetNameSafe(Sequence));
+            Stop();
+            return true;
+        }
+    }
+
+    // Frames sit at FrameIndex / FrameRate, a looping sequence blends its last frame back into the first
+    const int32 NumFrames = Sequence->GetNumFrames();
+    const float FrameRate = Sequence->FrameRate;
+    float FramePosition = FMath::Max(Time + DeltaTime, 0.0f) * FrameRate;
+    FramePosition = bLoop ? FMath::Fmod(FramePosition, (float)NumFrames) : FMath::Min(FramePosition, (float)(NumFrames - 1));
+    Time = FramePosition / FrameRate;
+
+    const int32 FrameA = FMath::Min(FMath::FloorToInt(FramePosition), NumFrames - 1);
+    const int32 FrameB = bLoop ? (FrameA + 1) % NumFrames : FMath::Min(FrameA + 1, NumFrames - 1);
+
+    // A late decode keeps the last pair on display rather than showing a hole
+    bool bViewChanged = false;
+    const int32 SlotA = FindSlot(FrameA);
+    const int32 SlotB = FindSlot(FrameB);
+    if (SlotA != INDEX_NONE && SlotB != INDEX_NONE)
+    {
+        if (SlotA != DisplaySlotA || SlotB != DisplaySlotB)
+        {
+            PreviousSlotA = DisplaySlotA;
+            PreviousSlotB = DisplaySlotB;
+            DisplaySlotA = SlotA;
+            DisplaySlotB = SlotB;
+            bViewChanged = true;
+        }
+
+        // A held last frame has nothing to blend with
+        const float Alpha = FMath::Clamp(FramePosition - FrameA, 0.0f, 1.0f);
+        bViewChanged |= SlotA != SlotB && Alpha != DisplayAlpha;
+        DisplayAlpha = Alpha;
+        bHasFrames.store(true, std::memory_order_release);
+    }
+    else
+    {
+        INC_DWORD_STAT(STAT_WindField_SequenceStalls);
+    }
+
+    if (DecodeRequestsInFlight.Num() == 0)
+    {
+        QueueDecodes(FrameA);
+    }
+
+    SET_MEMORY_STAT(STAT_WindField_SequenceMemory, GetAllocatedSize());
+    return bViewChanged;
+}
+
+int32 FWindSequencePlayer::FindSlot(int32 Frame) const
+{
+    return Slots.IndexOfByPredicate([Frame](const FSlot& Slot) { return Slot.Frame == Frame; });
+}
+
+bool FWindSequencePlayer::IsSlotInUse(int32 SlotIndex, int32 FirstFrame) const
+{
+    if (SlotIndex == DisplaySlotA || SlotIndex == DisplaySlotB || SlotIndex == PreviousSlotA || SlotIndex == PreviousSlotB)
+    {
+        return true;
+    }
+    if (DecodeRequestsInFlight.ContainsByPredicate([SlotIndex](const FDecodeRequest& Request) { return Request.Slot == SlotIndex; }))
+    {
+        return true;
+    }
+
+    const int32 Frame = Slots[SlotIndex].Frame;
+    if (Frame == INDEX_NONE)
+    {
+        return false;
+    }
+    int32 Distance = Frame - FirstFrame;
+    if (bLoop && Distance < 0)
+    {
+        Distance += Sequence->GetNumFrames();
+    }
+    return Distance >= 0 && Distance < WindowFrames;
+}
+
+void FWindSequencePlayer::QueueDecodes(int32 FirstFrame)
+{
+    const int32 NumFrames = Sequence->GetNumFrames();
+    for (int32 Offset = 0; Offset < WindowFrames; ++Offset)
+    {
+        int32 Frame = FirstFrame + Offset;
+        if (Frame >= NumFrames)
+        {
+            if (!bLoop)
+            {
+                break;
+            }
+            Frame -= NumFrames;
+        }
+        if (FindSlot(Frame) != INDEX_NONE)
+        {
+            continue;
+        }
+
+        // There are always two slots more than the window, enough for the pair that was on display before it
+        int32 FreeSlot = INDEX_NONE;
+        for (int32 SlotIndex = 0; SlotIndex < Slots.Num() && FreeSlot == INDEX_NONE; ++SlotIndex)
+        {
+            FreeSlot = IsSlotInUse(SlotIndex, FirstFrame) ? INDEX_NONE : SlotIndex;
+        }
+        if (FreeSlot == INDEX_NONE)
+        {
+            break;
+        }
+
+        Slots[FreeSlot].Frame = INDEX_NONE;
+        DecodeRequestsInFlight.Add({ Frame, FreeSlot });
+    }
+
+    if (DecodeRequestsInFlight.Num() > 0)
+    {
+        DecodeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+        {
+            DecodeRequests();
+        });
+    }
+}
+
+void FWindSequencePlayer::DecodeRequests()
+{
+    for (const FDecodeRequest& Request : DecodeRequestsInFlight)
+    {
+        // Deltas chain on from the frame decoded last, anything else replays from the keyframe before the request
+        const int32 Frame = Request.Frame;
+        int32 FrameToDecode = Frame;
+        if (!Sequence->IsKeyframe(Frame) && DecoderFrame != Frame - 1)
+        {
+            FrameToDecode = Frame - Frame % Sequence->GetKeyframeInterval();
+        }
+
+        for (; FrameToDecode <= Frame; ++FrameToDecode)
+        {
+            if (!Sequence->DecodeFrame(FrameToDecode, DecoderState, DecoderScratch))
+            {
+                DecoderFrame = INDEX_NONE;
+                bDecodeFailed = true;
+                return;
+            }
+            DecoderFrame = FrameToDecode;
+        }
+
+        Slots[Request.Slot].Channels = DecoderState;
+    }
+}
+
+bool FWindSequencePlayer::MakeView(FWindGridView& View) const
+{
+    if (!Sequence || !HasFrames())
+    {
+        return false;
+    }
+
+    const FWindPackedChannels& Current = Slots[DisplaySlotB].Channels;
+    View.X = Current.X.GetData();
+    View.Y = Current.Y.GetData();
+    View.Z = Current.Z.GetData();
+    View.Precision = Current.Precision;
+    View.DecodeScale = Current.DecodeScale;
+    View.Layout = EWindGridLayout::Linear;
+    View.SizeX = Sequence->GridSize.X;
+    View.SizeY = Sequence->GridSize.Y;
+    View.SizeZ = Sequence->GridSize.Z;
+    View.CellSize = Sequence->CellSize;
+    View.RingOffset = FIntVector::ZeroValue;
+    View.GridOffset = Sequence->GridOffset;
+
+    // Both frames share the quantization of the sequence, so the view blends them like two simulation steps
+    if (DisplaySlotA != DisplaySlotB)
+    {
+        const FWindPackedChannels& Previous = Slots[DisplaySlotA].Channels;
+        View.PrevX = Previous.X.GetData();
+        View.PrevY = Previous.Y.GetData();
+        View.PrevZ = Previous.Z.GetData();
+        View.Alpha = DisplayAlpha;
+    }
+    return true;
+}
+
+SIZE_T FWindSequencePlayer::GetAllocatedSize() const
+{
+    SIZE_T Bytes = Slots.GetAllocatedSize() + DecoderScratch.GetAllocatedSize();
+    for (const FSlot& Slot : Slots)
+    {
+        Bytes += Slot.Channels.X.GetAllocatedSize() + Slot.Channels.Y.GetAllocatedSize() + Slot.Channels.Z.GetAllocatedSize();
+    }
+    Bytes += DecoderState.X.GetAllocatedSize() + DecoderState.Y.GetAllocatedSize() + DecoderState.Z.GetAllocatedSize();
+    return Bytes;
+}
@@ -2,211 +2,2334 @@
 
 #include "WindVectorField.h"
 #include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
+#include "Serialization/CustomVersion.h"
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+DECLARE_CYCLE_STAT(TEXT("Update"), STAT_WindField_Update, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Step"), STAT_WindField_Step, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Advect"), STAT_WindField_Advect, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Fused Step"), STAT_WindField_FusedStep, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Sparse Step"), STAT_WindField_SparseStep, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Pressure Projection"), STAT_WindField_Projection, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Vorticity Confinement"), STAT_WindField_VorticityConfinement, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Sample Batch"), STAT_WindField_SampleBatch, STATGROUP_WindField);
+DECLARE_CYCLE_STAT(TEXT("Rebuild Force Field"), STAT_WindField_RebuildForceField, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Evaluations"), STAT_WindField_NoiseEvaluations, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Noise Evaluations Saved"), STAT_WindField_NoiseEvaluationsSaved, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batch Samples"), STAT_WindField_BatchSamples, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Steps Deferred"), STAT_WindField_AsyncStepsDeferred, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scrolled Cells Reseeded"), STAT_WindField_ScrollReseededCells, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fixed Steps"), STAT_WindField_FixedSteps, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fixed Steps Dropped"), STAT_WindField_FixedStepsDropped, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Clipmap Level Steps"), STAT_WindField_ClipmapLevelSteps, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Quiescent Tiles Skipped"), STAT_WindField_QuiescentTilesSkipped, STATGROUP_WindField);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pressure V-Cycles"), STAT_WindField_PressureVCycles, STATGROUP_WindField);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Bricks"), STAT_WindField_ActiveBricks, STATGROUP_WindField);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Tiles"), STAT_WindField_ActiveTiles, STATGROUP_WindField);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Active Tiles %"), STAT_WindField_ActiveTilePercent, STATGROUP_WindField);
+DECLARE_MEMORY_STAT(TEXT("Velocity Memory"), STAT_WindField_VelocityMemory, STATGROUP_WindField);
+DECLARE_MEMORY_STAT(TEXT("Brick Memory"), STAT_WindField_BrickMemory, STATGROUP_WindField);
+DECLARE_MEMORY_STAT(TEXT("Pressure Memory"), STAT_WindField_PressureMemory, STATGROUP_WindField);
+DECLARE_MEMORY_STAT(TEXT("Vorticity Memory"), STAT_WindField_VorticityMemory, STATGROUP_WindField);
+
+// Asset versions, anything saved before the steady state bake has no bulk data after the properties
+struct FWindVectorFieldCustomVersion
+{
+    enum Type
+    {
+        BeforeCustomVersionWasAdded = 0,
+        SteadyStateBulkData = 1,
+
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    static const FGuid GUID;
+};
+
+const FGuid FWindVectorFieldCustomVersion::GUID(0x5AA5D627, 0x800A430A, 0x96CB7BBA, 0x0C05BA15);
+static FCustomVersionRegistration GRegisterWindVectorFieldCustomVersion(FWindVectorFieldCustomVersion::GUID, FWindVectorFieldCustomVersion::LatestVersion, TEXT("WindVectorFieldVer"));
+
+static constexpr float WindDecayRate = 1.0f; // Adjust this to control how fast wind slows down
+
+UWindVectorField::UWindVectorField() 
+{
+    // Read together with the properties, so the steady state is in memory by the time PostLoad wants it
+    SteadyState.SetBulkDataFlags(BULKDATA_ForceInlinePayload);
+}
+
+void UWindVectorField::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    Ar.UsingCustomVersion(FWindVectorFieldCustomVersion::GUID);
+    if (Ar.CustomVer(FWindVectorFieldCustomVersion::GUID) >= FWindVectorFieldCustomVersion::SteadyStateBulkData)
+    {
+        SteadyState.Serialize(Ar, this);
+    }
+}
+
+void UWindVectorField::Initialize()
+{
+    // A background Initialize is already building the grid, callers of this one expect it done when we return
+    if (bInitialized)
+    {
+        if (!IsReady())
+        {
+            WaitForAsyncUpdate();
+        }
+        return;
+    }
+
+    if (SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize <= 0.0f)
+    {
+        return;
+    }
+
+    // Sparse fields start out as calm ambient wind, there is nothing to allocate or warm up
+    if (IsSparse())
+    {
+        Bricks.Reset();
+        bInitialized = true;
+        bReady = true;
+        return;
+    }
+
+    InitializeGrid();
+
+    bInitialized = true;
+    bReady = true;
+
+    NotifyReady();
+}
+
+void UWindVectorField::InitializeAsync()
+{
+    if (bInitialized || SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize <= 0.0f)
+    {
+        return;
+    }
+
+    if (IsSparse())
+    {
+        Initialize();
+        return;
+    }
+
+    // Claimed up front so a second call does not start over. The task takes the async step slot, so
+    // WaitForAsyncUpdate, ResetField and BeginDestroy all wait for it like they would for a step.
+    bInitialized = true;
+    bNotifyReady = true;
+    AsyncStepTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+    {
+        InitializeGrid();
+        bReady.store(true, std::memory_order_release);
+
+        // Readers that copied the invalid view before this point see a new version, with or without an Update
+        BumpGridVersion();
+    });
+}
+
+void UWindVectorField::InitializeGrid()
+{
+    AllocateFrontBuffer();
+
+    // The baked grids are what the noise and warm-up below would arrive at anyway
+    if (LoadSteadyState())
+    {
+        return;
+    }
+
+    RebuildForceField();
+
+    WarmUp();
+}
+
+uint32 UWindVectorField::ComputeSteadyStateKey() const
+{
+    // Everything the force field and the warm-up depend on
+    uint32 Key = GetTypeHash(FIntVector(SizeX, SizeY, SizeZ));
+    Key = HashCombine(Key, GetTypeHash(CellSize));
+    Key = HashCombine(Key, GetTypeHash(WindNoiseFrequency));
+    Key = HashCombine(Key, GetTypeHash(WindNoiseSeed));
+    Key = HashCombine(Key, GetTypeHash(WindScale));
+    Key = HashCombine(Key, GetTypeHash(WindBias));
+    Key = HashCombine(Key, GetTypeHash(TurbulenceStrength));
+    Key = HashCombine(Key, GetTypeHash(NoiseScale));
+    Key = HashCombine(Key, GetTypeHash((uint8)AdvectionScheme));
+    Key = HashCombine(Key, GetTypeHash((uint32)bProjectIncompressible));
+    Key = HashCombine(Key, GetTypeHash(VorticityStrength));
+    Key = HashCombine(Key, GetTypeHash((uint8)SolverMode));
+    Key = HashCombine(Key, GetTypeHash(MaxPressureVCycles));
+    Key = HashCombine(Key, GetTypeHash(PressureBudgetMicroseconds));
+
+    // Solid cells depend on where the grid sits over the mask
+    if (bUseObstacleMask && ObstacleMask.IsBaked())
+    {
+        Key = HashCombine(Key, GetTypeHash(ObstacleMask.NumSolidCells));
+        Key = HashCombine(Key, GetTypeHash(ObstacleMask.Origin));
+        Key = HashCombine(Key, GetTypeHash(FieldOrigin));
+    }
+    return Key;
+}
+
+bool UWindVectorField::HasValidSteadyState() const
+{
+    const int64 ExpectedSize = (int64)SizeX * SizeY * SizeZ * 6 * sizeof(float);
+    return !IsSparse() && SteadyState.GetBulkDataSize() == ExpectedSize && SteadyStateKey == ComputeSteadyStateKey();
+}
+
+bool UWindVectorField::LoadSteadyState()
+{
+    if (!HasValidSteadyState())
+    {
+        if (SteadyState.GetBulkDataSize() > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Baked wind steady state of %s no longer matches its settings, warming up instead. Re-bake the asset."), *GetNameSafe(this));
+        }
+        return false;
+    }
+
+    const int32 NumCells = SizeX * SizeY * SizeZ;
+    Force.SetNumZeroed(GetStorageCellCount());
+    SolidCells.Init(0, (GetStorageCellCount() + 63) / 64);
+
+    const float* RESTRICT Data = static_cast<const float*>(SteadyState.LockReadOnly());
+    const bool bPacked = IsPacked();
+    for (int32 z = 0; z < SizeZ; ++z)
+    {
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            int32 WindowIndex = (y + z * SizeY) * SizeX;
+            for (int32 x = 0; x < SizeX; ++x, ++WindowIndex)
+            {
+                const int32 Index = GetIndex(x, y, z);
+                const FVector3f CellVelocity(Data[WindowIndex], Data[WindowIndex + NumCells], Data[WindowIndex + NumCells * 2]);
+                if (bPacked)
+                {
+                    PackedVelocity.Set(Index, CellVelocity);
+                }
+                else
+                {
+                    Velocity.Set(Index, CellVelocity);
+                }
+                Force.Set(Index, FVector3f(Data[WindowIndex + NumCells * 3], Data[WindowIndex + NumCells * 4], Data[WindowIndex + NumCells * 5]));
+                SetSolidCell(Index, IsObstacleCell(x, y, z));
+            }
+        }
+    }
+    SteadyState.Unlock();
+
+    bForceFieldDirty = false;
+    WakeAllTiles();
+    BumpGridVersion();
+    return true;
+}
+
+#if WITH_EDITOR
+void UWindVectorField::BakeSteadyState()
+{
+    if (IsSparse() || SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize <= 0.0f)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BakeSteadyState: %s has no dense grid to bake"), *GetNameSafe(this));
+        return;
+    }
+
+    // A scratch field with this one as its template copies every setting, but not the bulk data, so it always warms up
+    UWindVectorField* Baker = NewObject<UWindVectorField>(GetTransientPackage(), NAME_None, RF_Transient, this);
+    Baker->NumClipmapLevels = 1;
+    Baker->bScrollWithTarget = false;
+    Baker->bAsyncSimulation = false;
+    Baker->WarmUpSteps = SteadyStateBakeSteps;
+    Baker->Initialize();
+
+    const int32 NumCells = SizeX * SizeY * SizeZ;
+    const FWindGridView View = Baker->MakeGridView(false);
+    if (!View.IsValid() || Baker->Force.Num() != Baker->GetStorageCellCount())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BakeSteadyState: %s failed to simulate"), *GetNameSafe(this));
+        Baker->MarkAsGarbage();
+        return;
+    }
+
+    Modify();
+    SteadyState.Lock(LOCK_READ_WRITE);
+    float* Data = static_cast<float*>(SteadyState.Realloc((int64)NumCells * 6 * sizeof(float)));
+    for (int32 z = 0; z < SizeZ; ++z)
+    {
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            int32 WindowIndex = (y + z * SizeY) * SizeX;
+            for (int32 x = 0; x < SizeX; ++x, ++WindowIndex)
+            {
+                const int32 Index = Baker->GetIndex(x, y, z);
+                const FVector3f CellVelocity = View.GetCell(Index);
+                const FVector3f CellForce = Baker->Force.Get(Index);
+                Data[WindowIndex] = CellVelocity.X;
+                Data[WindowIndex + NumCells] = CellVelocity.Y;
+                Data[WindowIndex + NumCells * 2] = CellVelocity.Z;
+                Data[WindowIndex + NumCells * 3] = CellForce.X;
+                Data[WindowIndex + NumCells * 4] = CellForce.Y;
+                Data[WindowIndex + NumCells * 5] = CellForce.Z;
+            }
+        }
+    }
+    SteadyState.Unlock();
+    SteadyState.StoreCompressedOnDisk(NAME_Zlib);
+    SteadyStateKey = ComputeSteadyStateKey();
+
+    Baker->MarkAsGarbage();
+    MarkPackageDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("Baked wind steady state of %s after %d steps, %lld bytes"), *GetNameSafe(this), SteadyStateBakeSteps, SteadyState.GetBulkDataSize());
+}
+
+void UWindVectorField::ClearSteadyState()
+{
+    Modify();
+    SteadyState.RemoveBulkData();
+    SteadyStateKey = 0;
+    MarkPackageDirty();
+}
+#endif
+
+bool UWindVectorField::PlaySequence(UWindSequence* Sequence, float StartTime)
+{
+    if (!Sequence || Sequence->GetNumFrames() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PlaySequence: %s has no frames to play"), *GetNameSafe(Sequence));
+        return false;
+    }
+
+    // The sequence replaces the dense grid, so Niagara and the clipmap levels have to agree with it
+    if (IsSparse() || Sequence->GridSize != FIntVector(SizeX, SizeY, SizeZ) || !FMath::IsNearlyEqual(Sequence->CellSize, CellSize))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PlaySequence: %s was recorded on a %dx%dx%d grid of %.1f cells, which %s does not match"),
+            *GetNameSafe(Sequence), Sequence->GridSize.X, Sequence->GridSize.Y, Sequence->GridSize.Z, Sequence->CellSize, *GetNameSafe(this));
+        return false;
+    }
+
+    FWriteScopeLock WriteLock(PublishLock);
+    SequencePlayer.Start(Sequence, StartTime, SequenceReadAheadFrames, bLoopSequence);
+    PlayingSequence = Sequence;
+    BumpGridVersion();
+    return true;
+}
+
+void UWindVectorField::StopSequence()
+{
+    FWriteScopeLock WriteLock(PublishLock);
+    if (PlayingSequence)
+    {
+        SequencePlayer.Stop();
+        PlayingSequence = nullptr;
+        BumpGridVersion();
+    }
+}
+
+void UWindVectorField::WarmUp()
+{
+    // Steps the window where it is, the scroll target is looked up by the first Update on the game thread
+    const float FixedDeltaTime = 0.016f;
+    for (int32 Step = 0; Step < WarmUpSteps; ++Step)
+    {
+        PrepareStep(false);
+        StepSimulation(FixedDeltaTime);
+    }
+}
+
+void UWindVectorField::NotifyReady()
+{
+    // Clipmap levels are UObjects, they can only be created here on the game thread
+    bNotifyReady = false;
+    TArray<TFunction<void()>> Setters = MoveTemp(DeferredSetters);
+    DeferredSetters.Reset();
+    for (const TFunction<void()>& Setter : Setters)
+    {
+        Setter();
+    }
+    SyncClipmapLevels();
+
+    // The view was invalid until now, whatever was copied from it is stale
+    BumpGridVersion();
+    OnReady.Broadcast();
+}
+
+bool UWindVectorField::DeferUntilReady(TFunction<void()>&& Setter)
+{
+    // The initialization task reads the settings and clears bForceFieldDirty once it built from them. Anything
+    // queued so far has to land first, so the queue is used until NotifyReady drained it.
+    if (!bNotifyReady && (!bInitialized || IsReady()))
+    {
+        return false;
+    }
+    DeferredSetters.Add(MoveTemp(Setter));
+    return true;
+}
+
+void UWindVectorField::AllocateFrontBuffer()
+{
+    const int32 NumCells = GetStorageCellCount();
+    if (IsPacked())
+    {
+        PackedVelocity.Configure(VelocityPrecision, QuantizationMaxSpeed);
+        PackedVelocity.SetNumZeroed(NumCells);
+    }
+    else
+    {
+        Velocity.SetNumZeroed(NumCells);
+    }
+    BumpGridVersion();
+}
+
+void UWindVectorField::BeginDestroy()
+{
+    // The async step and the sequence decodes capture this object, they have to finish before we go away
+    WaitForAsyncUpdate();
+    StopSequence();
+
+    Super::BeginDestroy();
+}
+
+void UWindVectorField::PostLoad()
+{
+    Super::PostLoad();
+
+    if (GetAllocatedCells() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PostLoad: Initializing wind field"));
+
+        // A baked steady state is only a copy, there is nothing worth moving off this thread
+        if (bAsyncInitialize && !HasValidSteadyState())
+        {
+            InitializeAsync();
+        }
+        else
+        {
+            Initialize();
+        }
+    }
+}
+
+int UWindVectorField::GetIndex(int X, int Y, int Z) const
+{
+    // Window-local coordinates are rotated by the ring offset, which is zero unless the grid scrolls
+    return FWindGridView::ComputeStorageIndex(GridLayout,
+        FWindGridView::WrapOnce(X + RingOffset.X, SizeX),
+        FWindGridView::WrapOnce(Y + RingOffset.Y, SizeY),
+        FWindGridView::WrapOnce(Z + RingOffset.Z, SizeZ),
+        SizeX, SizeY);
+}
+
+bool UWindVectorField::IsValidIndex(int X, int Y, int Z) const
+{
+    return X >= 0 && X < SizeX &&
+           Y >= 0 && Y < SizeY &&
+           Z >= 0 && Z < SizeZ;
+}
+
+void UWindVectorField::Advect(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_Advect);
+
+    EnsureBackBuffer();
+
+    // Every cell only reads the front buffer and writes its own back buffer cell, so Z slabs are independent
+    ParallelFor(SizeZ, [this, DeltaTime](int32 z)
+    {
+        AdvectSlab(z, DeltaTime);
+    }, bParallelSolve ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void UWindVectorField::EnsureBackBuffer()
+{
+    // The back buffer persists between frames, it is only reallocated when the grid is resized
+    if (IsPacked())
+    {
+        if (PackedBackVelocity.Num() != PackedVelocity.Num())
+        {
+            PackedBackVelocity.Configure(VelocityPrecision, QuantizationMaxSpeed);
+            PackedBackVelocity.SetNumZeroed(PackedVelocity.Num());
+        }
+        if (bAsyncSimulation && PackedRetiredVelocity.Num() != PackedVelocity.Num())
+        {
+            PackedRetiredVelocity = PackedVelocity;
+        }
+    }
+    else
+    {
+        // Zeroed rather than uninitialized, tile padding is never written by the solver
+        if (BackVelocity.Num() != Velocity.Num())
+        {
+            BackVelocity.SetNumZeroed(Velocity.Num());
+        }
+
+        // The third buffer is only needed while readers may run concurrently with the solver
+        if (bAsyncSimulation && RetiredVelocity.Num() != Velocity.Num())
+        {
+            // Seeded with the current step so an interpolating reader never blends towards an empty grid
+            RetiredVelocity = Velocity;
+        }
+    }
+
+    // Sized here rather than in the step, UsesMacCormack only reports true once the scratch matches the grid
+    if (AdvectionScheme == EWindAdvectionScheme::MacCormack)
+    {
+        if (AdvectScratch.Num() != GetAllocatedCells())
+        {
+            AdvectScratch.SetNumZeroed(GetAllocatedCells());
+        }
+    }
+    else
+    {
+        AdvectScratch.Empty();
+    }
+
+    SET_MEMORY_STAT(STAT_WindField_VelocityMemory,
+        (Velocity.Num() + BackVelocity.Num() + RetiredVelocity.Num() + SubstepVelocity.Num() + AdvectScratch.Num()) * 3 * sizeof(float)
+        + (PackedVelocity.Num() + PackedBackVelocity.Num() + PackedRetiredVelocity.Num() + PackedSubstepVelocity.Num()) * 3 * sizeof(uint16));
+}
+
+void UWindVectorField::EnsureSubstepBuffer()
+{
+    // Only async fixed-rate fields that fell behind need it, allocated the first time they do
+    if (IsPacked())
+    {
+        if (PackedSubstepVelocity.Num() != PackedVelocity.Num())
+        {
+            PackedSubstepVelocity.Configure(VelocityPrecision, QuantizationMaxSpeed);
+            PackedSubstepVelocity.SetNumZeroed(PackedVelocity.Num());
+        }
+    }
+    else if (SubstepVelocity.Num() != Velocity.Num())
+    {
+        SubstepVelocity.SetNumZeroed(Velocity.Num());
+    }
+}
+
+void UWindVectorField::PublishBackBuffer()
+{
+    // Swapping the channel arrays only exchanges their allocations, nothing is copied
+    FWriteScopeLock WriteLock(PublishLock);
+    Swap(Velocity, BackVelocity);
+    Swap(PackedVelocity, PackedBackVelocity);
+    bHoldGridView = false;
+    QuiescentStepCount = bStepChangedGrid ? 0 : QuiescentStepCount + 1;
+
+    // A scrolled window shows every cell somewhere else
+    if (RingOffset != LastPublishedRingOffset)
+    {
+        DirtySlices.Init(true, SizeZ);
+        LastPublishedRingOffset = RingOffset;
+    }
+
+    // A step that only copied sleeping tiles publishes the same wind again
+    const bool bBlending = SimulationAlpha < 1.0f || (PendingSimulationAlpha >= 0.0f && PendingSimulationAlpha < 1.0f);
+    if (bStepChangedGrid)
+    {
+        // Mid-blend the view moves from the last pair of steps to this one, the cells of both steps change
+        TBitArray<> ChangedSlices = DirtySlices;
+        if (bBlending && LastStepDirtySlices.Num() == ChangedSlices.Num())
+        {
+            ChangedSlices.CombineWithBitwiseOR(LastStepDirtySlices, EBitwiseOperatorFlags::MinSize);
+        }
+        BumpGridVersion(&ChangedSlices);
+        LastStepDirtySlices = DirtySlices;
+    }
+    else if (bBlending && QuiescentStepCount == 1)
+    {
+        // The first unchanged step still moves the view off the blend into the last step that changed anything
+        BumpGridVersion(LastStepDirtySlices.Num() == SizeZ ? &LastStepDirtySlices : nullptr);
+    }
+
+    // An async fixed step goes live with the blend UpdateFixedRate worked out for it, before that readers would
+    // see the old pair of steps blended by the new alpha
+    if (PendingSimulationAlpha >= 0.0f)
+    {
+        SimulationAlpha = PendingSimulationAlpha;
+        PendingSimulationAlpha = -1.0f;
+    }
+
+    // Async: rotate the previous front into the retired slot, readers that grabbed it keep a valid grid
+    // for one more step, and the next step writes into the buffer that is two steps old
+    if (bAsyncSimulation && RetiredVelocity.Num() == BackVelocity.Num())
+    {
+        Swap(BackVelocity, RetiredVelocity);
+    }
+    if (bAsyncSimulation && PackedRetiredVelocity.Num() == PackedBackVelocity.Num())
+    {
+        Swap(PackedBackVelocity, PackedRetiredVelocity);
+    }
+}
+
+void UWindVectorField::AdvectSlab(int32 z, float DeltaTime)
+{
+    for (int y = 0; y < SizeY; ++y)
+    {
+        for (int x = 0; x < SizeX; ++x)
+        {
+            int idx = GetIndex(x, y, z);
+            FVector3f currentVelocity = Velocity.Get(idx);
+
+            // Calculate where the wind came from (backtrace)
+            FVector3f worldPos = FVector3f(x, y, z) * CellSize;
+            FVector3f prevPos = worldPos - currentVelocity * DeltaTime;
+
+            // Convert prevPos to grid coords (from world coordinates)
+            FVector3f gridPos = prevPos / CellSize;
+
+            // Trilinear interpolation for velocity at prevPos
+            FVector3f advectedVelocity = SampleVelocityAtGridPosition(gridPos);
+
+            BackVelocity.Set(idx, advectedVelocity * GetOpenFactor(idx));
+        }
+    }
+}
+
+float UWindVectorField::GetDecayFactor(float DeltaTime)
+{
+    return FMath::Max(0.0f, 1.0f - WindDecayRate * DeltaTime);
+}
+
+void UWindVectorField::DecayVelocity(float DeltaTime)
+{
+    const float Decay = GetDecayFactor(DeltaTime);
+
+    // One flat loop per channel so the compiler can vectorize them
+    for (FWindVectorChannels::FChannel* Channel : { &BackVelocity.X, &BackVelocity.Y, &BackVelocity.Z })
+    {
+        float* RESTRICT Data = Channel->GetData();
+        const int32 NumCells = Channel->Num();
+        for (int32 Index = 0; Index < NumCells; ++Index)
+        {
+            Data[Index] *= Decay;
+        }
+    }
+}
+
+FVector3f UWindVectorField::SampleVelocityAtGridPosition(const FVector3f& GridPos) const
+{
+    // Ensure grid in initialized
+    if (Velocity.Num() == 0 || SizeX <= 1 || SizeY <= 1 || SizeZ <= 1)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SampleVelocityAtGridPosition called with uninitialized or too small grid"));
+        return FVector3f::ZeroVector;
+    }
+
+    // GridPos components can be fractional
+    int x0 = FMath::FloorToInt(GridPos.X);
+    int y0 = FMath::FloorToInt(GridPos.Y);
+    int z0 = FMath::FloorToInt(GridPos.Z);
+
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+    int z1 = z0 + 1;
+
+    // Clamp indices to enure they're within bounds
+    x0 = FMath::Clamp(x0, 0, SizeX - 1);
+    y0 = FMath::Clamp(y0, 0, SizeY - 1);
+    z0 = FMath::Clamp(z0, 0, SizeZ - 1);
+
+    x1 = FMath::Clamp(x1, 0, SizeX - 1);
+    y1 = FMath::Clamp(y1, 0, SizeY - 1);
+    z1 = FMath::Clamp(z1, 0, SizeZ - 1);
+
+    // Ensure all indices are still valid
+    auto SafeGet = [&](int X, int Y, int Z)
+    {
+        return IsValidIndex(X, Y, Z) ? Velocity.Get(GetIndex(X, Y, Z)) : FVector3f::ZeroVector;
+    };
+
+    // Get Velocity at corners
+    FVector3f c000 = SafeGet(x0, y0, z0);
+    FVector3f c100 = SafeGet(x1, y0, z0);
+    FVector3f c010 = SafeGet(x0, y1, z0);
+    FVector3f c110 = SafeGet(x1, y1, z0);
+    FVector3f c001 = SafeGet(x0, y0, z1);
+    FVector3f c101 = SafeGet(x1, y0, z1);
+    FVector3f c011 = SafeGet(x0, y1, z1);
+    FVector3f c111 = SafeGet(x1, y1, z1);
+
+    // Fractional distance within the cell
+    float sx = GridPos.X - x0;
+    float sy = GridPos.Y - y0;
+    float sz = GridPos.Z - z0;
+
+    // Interpolate along X
+    FVector3f c00 = FMath::Lerp(c000, c100, sx);
+    FVector3f c10 = FMath::Lerp(c010, c110, sx);
+    FVector3f c01 = FMath::Lerp(c001, c101, sx);
+    FVector3f c11 = FMath::Lerp(c011, c111, sx);
+
+    // Interpolate along Y
+    FVector3f c0 = FMath::Lerp(c00, c10, sy);
+    FVector3f c1 = FMath::Lerp(c01, c11, sy);
+
+    // Interpolate along Z
+    FVector3f c = FMath::Lerp(c0, c1, sz);
+
+    //UE_LOG(LogTemp, Warning, TEXT("SampleWindAtPosition called on initialized field. Asset name: %s"), *GetNameSafe(this));
+
+    return c;
+}
+
+void UWindVectorField::Update(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_Update);
+
+    // A playing sequence stands in for the simulation, which stays paused where it was
+    if (IsPlayingSequence())
+    {
+        FWriteScopeLock WriteLock(PublishLock);
+        if (SequencePlayer.Advance(DeltaTime))
+        {
+            BumpGridVersion();
+        }
+        if (!SequencePlayer.IsPlaying())
+        {
+            PlayingSequence = nullptr;
+        }
+        return;
+    }
+
+    // Still warming up in the background
+    if (bInitialized && !IsReady())
+    {
+        return;
+    }
+
+    const bool bAllocated = IsSparse() ? bInitialized : GetAllocatedCells() > 0;
+    if (!bAllocated)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[WindField] Update called before Initialize! Skipping update."));
+        return;
+    }
+
+    if (bNotifyReady)
+    {
+        WaitForAsyncUpdate();
+        NotifyReady();
+    }
+
+    UpdateClipmapLevels(DeltaTime);
+
+    if (bFixedTimestep)
+    {
+        UpdateFixedRate(DeltaTime);
+        return;
+    }
+
+    if (bAsyncSimulation)
+    {
+        LaunchAsyncStep(DeltaTime);
+        return;
+    }
+
+    // Switching back to synchronous updates, make sure no worker still owns the buffers
+    WaitForAsyncUpdate();
+
+    PrepareStep();
+    StepSimulation(DeltaTime);
+}
+
+void UWindVectorField::PrepareStep(bool bUpdateScrollWindow)
+{
+    // Anything touching shared solver state happens here on the calling thread, while no step is in flight
+    if (IsSparse())
+    {
+        return;
+    }
+
+    if (bUpdateScrollWindow)
+    {
+        UpdateScrollWindow();
+    }
+
+    EnsureActivityTiles();
+    StepFieldOrigin = FieldOrigin;
+
+    if (bForceFieldDirty || Force.Num() != GetAllocatedCells() || SolidCells.Num() != (GetAllocatedCells() + 63) / 64)
+    {
+        RebuildForceField();
+    }
+    else if (bSolidCellsDirty)
+    {
+        ResampleSolidCells();
+    }
+
+    EnsureBackBuffer();
+}
+
+void UWindVectorField::StepSimulation(float DeltaTime)
+{
+    if (IsSparse())
+    {
+        StepSparse(DeltaTime);
+        return;
+    }
+
+    SolveStep(DeltaTime);
+    PublishBackBuffer();
+}
+
+void UWindVectorField::StepSimulationBatch(float DeltaTime, int32 NumSteps)
+{
+    // Bricks are published under the lock and never pinned, a sparse field can publish every step
+    if (IsSparse() || NumSteps <= 1)
+    {
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            StepSimulation(DeltaTime);
+        }
+        return;
+    }
+
+    // Readers may pin the published front and the retired step until the batch publishes. The front is parked in
+    // the substep buffer meanwhile, the steps in between ping-pong through it and the back buffer.
+    {
+        FWriteScopeLock WriteLock(PublishLock);
+        HeldGridView = MakeGridViewLocked(bFixedTimestep);
+        bHoldGridView = true;
+    }
+
+    bool bBatchChangedGrid = false;
+    TBitArray<> BatchDirtySlices(false, SizeZ);
+    for (int32 Step = 0; Step < NumSteps; ++Step)
+    {
+        SolveStep(DeltaTime);
+        bBatchChangedGrid |= bStepChangedGrid;
+        BatchDirtySlices.CombineWithBitwiseOR(DirtySlices, EBitwiseOperatorFlags::MinSize);
+        if (Step + 1 == NumSteps)
+        {
+            break;
+        }
+
+        // This step is the input of the next one, which writes into whichever buffer nobody reads
+        FWriteScopeLock WriteLock(PublishLock);
+        Swap(Velocity, BackVelocity);
+        Swap(PackedVelocity, PackedBackVelocity);
+        if (Step == 0)
+        {
+            Swap(BackVelocity, SubstepVelocity);
+            Swap(PackedBackVelocity, PackedSubstepVelocity);
+        }
+    }
+
+    // The published front goes back in as the step before, so publishing retires it like after a single step
+    {
+        FWriteScopeLock WriteLock(PublishLock);
+        Swap(Velocity, SubstepVelocity);
+        Swap(PackedVelocity, PackedSubstepVelocity);
+    }
+    bStepChangedGrid = bBatchChangedGrid;
+    DirtySlices = MoveTemp(BatchDirtySlices);
+    PublishBackBuffer();
+}
+
+void UWindVectorField::SolveStep(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_Step);
+
+    // Every solver pass writes into the back buffer, readers only ever see complete steps.
+    // Packed grids always fuse, the split passes would round-trip every cell through 16 bits three times.
+    // Tiles are sized by PrepareStep, so a bSkipQuiescentTiles toggled mid-step only applies from the next one.
+    bStepChangedGrid = true;
+    ResetDirtySlices();
+    if (ActivityTiles.Num() > 0)
+    {
+        StepActiveTiles(DeltaTime);
+    }
+    else if (SolverMode == EWindSolverMode::Fused || IsPacked() || UsesMacCormack())
+    {
+        DirtySlices.Init(true, SizeZ);
+        StepFused(DeltaTime);
+    }
+    else
+    {
+        DirtySlices.Init(true, SizeZ);
+        Advect(DeltaTime);
+        DecayVelocity(DeltaTime);
+        ApplyForceField(DeltaTime);
+    }
+
+    // Confinement and projection are global, a change anywhere can move every cell
+    if ((VorticityStrength > 0.0f || bProjectIncompressible) && bStepChangedGrid)
+    {
+        DirtySlices.Init(true, SizeZ);
+    }
+
+    // Confinement is a force, so it goes in before the projection takes out what it adds in divergence
+    if (VorticityStrength > 0.0f && bStepChangedGrid)
+    {
+        if (IsPacked())
+        {
+            ConfineVorticity(PackedBackVelocity, DeltaTime);
+        }
+        else
+        {
+            ConfineVorticity(BackVelocity, DeltaTime);
+        }
+    }
+
+    // A step that left every tile asleep did not disturb the last projection
+    if (bProjectIncompressible && bStepChangedGrid)
+    {
+        if (IsPacked())
+        {
+            ProjectVelocity(PackedBackVelocity);
+        }
+        else
+        {
+            ProjectVelocity(BackVelocity);
+        }
+    }
+
+    if (IsPacked())
+    {
+        ApplyPendingInjections(PackedBackVelocity);
+    }
+    else
+    {
+        ApplyPendingInjections(BackVelocity);
+    }
+}
+
+void UWindVectorField::LaunchAsyncStep(float DeltaTime)
+{
+    PendingAsyncDeltaTime += DeltaTime;
+
+    // Never block the caller on the solver, if the last step is still running its time rolls into the next one
+    if (!AsyncStepTask.IsCompleted())
+    {
+        INC_DWORD_STAT(STAT_WindField_AsyncStepsDeferred);
+        return;
+    }
+
+    const float StepDeltaTime = PendingAsyncDeltaTime;
+    PendingAsyncDeltaTime = 0.0f;
+
+    LaunchAsyncStepTask(StepDeltaTime, 1);
+}
+
+void UWindVectorField::LaunchAsyncStepTask(float StepDeltaTime, int32 NumSteps)
+{
+    PrepareStep();
+    if (NumSteps > 1)
+    {
+        EnsureSubstepBuffer();
+    }
+
+    // One publish per task: the retired buffer readers may still pin is only written again by the next task,
+    // after this task's publish has moved every new view off it
+    AsyncStepTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, StepDeltaTime, NumSteps]()
+    {
+        StepSimulationBatch(StepDeltaTime, NumSteps);
+    });
+}
+
+void UWindVectorField::UpdateFixedRate(float DeltaTime)
+{
+    const float FixedDeltaTime = 1.0f / FMath::Max(SimulationRate, 1.0f);
+    SimulationAccumulator += DeltaTime;
+
+    if (!bAsyncSimulation)
+    {
+        WaitForAsyncUpdate();
+    }
+
+    // Async never waits on the solver, the time keeps accumulating until the running step is done. The blend
+    // stays where it is meanwhile, the step publishes the one that goes with its grid.
+    if (bAsyncSimulation && !AsyncStepTask.IsCompleted())
+    {
+        INC_DWORD_STAT(STAT_WindField_AsyncStepsDeferred);
+        return;
+    }
+
+    int32 NumSteps = FMath::FloorToInt(SimulationAccumulator / FixedDeltaTime);
+
+    // Falling behind, drop the excess instead of spending ever more substeps on it
+    const int32 MaxSteps = FMath::Max(MaxSubstepsPerUpdate, 1);
+    if (NumSteps > MaxSteps)
+    {
+        INC_DWORD_STAT_BY(STAT_WindField_FixedStepsDropped, NumSteps - MaxSteps);
+        SimulationAccumulator -= (NumSteps - MaxSteps) * FixedDeltaTime;
+        NumSteps = MaxSteps;
+    }
+
+    // Async runs every step owed in one task and publishes once at the end
+    if (bAsyncSimulation && NumSteps > 0)
+    {
+        INC_DWORD_STAT_BY(STAT_WindField_FixedSteps, NumSteps);
+        SimulationAccumulator -= NumSteps * FixedDeltaTime;
+        PendingSimulationAlpha = FMath::Clamp(SimulationAccumulator / FixedDeltaTime, 0.0f, 1.0f);
+        LaunchAsyncStepTask(FixedDeltaTime, NumSteps);
+        return;
+    }
+
+    SimulationAccumulator -= NumSteps * FixedDeltaTime;
+    if (NumSteps > 0)
+    {
+        INC_DWORD_STAT_BY(STAT_WindField_FixedSteps, NumSteps);
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            PrepareStep();
+            StepSimulation(FixedDeltaTime);
+        }
+    }
+
+    FWriteScopeLock WriteLock(PublishLock);
+    const float NewAlpha = FMath::Clamp(SimulationAccumulator / FixedDeltaTime, 0.0f, 1.0f);
+
+    // Once a step changed nothing the two blended steps hold the same wind, any blend of them does too
+    if (NewAlpha != SimulationAlpha && QuiescentStepCount == 0)
+    {
+        BumpGridVersion(LastStepDirtySlices.Num() == SizeZ ? &LastStepDirtySlices : nullptr);
+    }
+    SimulationAlpha = NewAlpha;
+}
+
+void UWindVectorField::WaitForAsyncUpdate()
+{
+    if (AsyncStepTask.IsValid())
+    {
+        AsyncStepTask.Wait();
+        AsyncStepTask = UE::Tasks::FTask();
+    }
+}
+
+void UWindVectorField::StepFused(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_FusedStep);
+
+    // The solver reads the raw front buffer, never the interpolated one
+    const FWindGridView Front = MakeGridView(false);
+    if (!Front.IsValid())
+    {
+        return;
+    }
+    const float Decay = GetDecayFactor(DeltaTime);
+    const EParallelForFlags Flags = bParallelSolve ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+    // The MacCormack corrector samples the prediction around each cell, so the whole grid is predicted first
+    const bool bMacCormack = UsesMacCormack();
+    const FWindGridView Predicted = MakePredictionView(Front);
+    if (bMacCormack)
+    {
+        ParallelFor(SizeZ, [this, &Front, DeltaTime](int32 z)
+        {
+            const FIntVector Min(0, 0, z);
+            const FIntVector Max(SizeX, SizeY, z + 1);
+            switch (Front.Precision)
+            {
+            case EWindVelocityPrecision::Half:  PredictBlock<EWindVelocityPrecision::Half>(Front, Min, Max, DeltaTime, true); break;
+            case EWindVelocityPrecision::Int16: PredictBlock<EWindVelocityPrecision::Int16>(Front, Min, Max, DeltaTime, true); break;
+            default:                            PredictBlock<EWindVelocityPrecision::Float32>(Front, Min, Max, DeltaTime, true); break;
+            }
+        }, Flags);
+    }
+
+    // Same slab split as Advect (in storage order), each cell is read from the front buffer and finished in one go
+    const FWindGridView* PredictedPtr = bMacCormack ? &Predicted : nullptr;
+    ParallelFor(SizeZ, [this, &Front, PredictedPtr, DeltaTime, Decay](int32 z)
+    {
+        const FIntVector Min(0, 0, z);
+        const FIntVector Max(SizeX, SizeY, z + 1);
+        switch (Front.Precision)
+        {
+        case EWindVelocityPrecision::Half:  StepFusedBlock<EWindVelocityPrecision::Half>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        case EWindVelocityPrecision::Int16: StepFusedBlock<EWindVelocityPrecision::Int16>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        default:                            StepFusedBlock<EWindVelocityPrecision::Float32>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        }
+    }, Flags);
+
+    INC_DWORD_STAT_BY(STAT_WindField_NoiseEvaluationsSaved, GetAllocatedCells() * 3);
+}
+
+void UWindVectorField::StepSparse(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_SparseStep);
+
+    // Advection and decay of the disturbance only, the ambient wind is already at its force/decay equilibrium
+    Bricks.Advect(DeltaTime, CellSize, GetDecayFactor(DeltaTime), GetAmbientWind(), bParallelSolve);
+
+    TArray<FPendingInjection> Injections = TakePendingInjections();
+    {
+        // Publishing can reallocate the bricks, readers sample under the read lock
+        FWriteScopeLock WriteLock(PublishLock);
+        Bricks.SwapAndUpdateActivity(BrickRetireSpeed, BrickRetireSteps, MaxActiveBricks);
+
+        for (const FPendingInjection& Injection : Injections)
+        {
+            Bricks.Inject(FVector3f(Injection.WorldPos / CellSize), FVector3f(Injection.Velocity), Injection.Radius / CellSize, MaxActiveBricks);
+        }
+    }
+
+    SET_DWORD_STAT(STAT_WindField_ActiveBricks, Bricks.GetNumActiveBricks());
+    SET_MEMORY_STAT(STAT_WindField_BrickMemory, Bricks.GetAllocatedSize());
+    BumpGridVersion();
+}
+
+template<typename ChannelsType>
+void UWindVectorField::ProjectVelocity(ChannelsType& Target)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_Projection);
+
+    PressureSolver.Resize(FIntVector(SizeX, SizeY, SizeZ));
+    SET_MEMORY_STAT(STAT_WindField_PressureMemory, PressureSolver.GetAllocatedSize());
+
+    const EParallelForFlags Flags = bParallelSolve ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+    // Central differences in cell units, so the solve does not depend on CellSize.
+    // Wind past the window faces is taken to carry on unchanged, the solver is indexed in window order.
+    float* RESTRICT Divergence = PressureSolver.GetDivergence();
+    ParallelFor(SizeZ, [this, &Target, Divergence](int32 z)
+    {
+        const int32 z0 = FMath::Max(z - 1, 0);
+        const int32 z1 = FMath::Min(z + 1, SizeZ - 1);
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            const int32 y0 = FMath::Max(y - 1, 0);
+            const int32 y1 = FMath::Min(y + 1, SizeY - 1);
+            for (int32 x = 0; x < SizeX; ++x)
+            {
+                const int32 x0 = FMath::Max(x - 1, 0);
+                const int32 x1 = FMath::Min(x + 1, SizeX - 1);
+                Divergence[x + (y + z * SizeY) * SizeX] = 0.5f * (
+                    Target.Get(GetIndex(x1, y, z)).X - Target.Get(GetIndex(x0, y, z)).X
+                    + Target.Get(GetIndex(x, y1, z)).Y - Target.Get(GetIndex(x, y0, z)).Y
+                    + Target.Get(GetIndex(x, y, z1)).Z - Target.Get(GetIndex(x, y, z0)).Z);
+            }
+        }
+    }, Flags);
+
+    const int32 NumCycles = PressureSolver.Solve(PressureBudgetMicroseconds * 1e-6, FMath::Max(MaxPressureVCycles, 1), bParallelSolve);
+    INC_DWORD_STAT_BY(STAT_WindField_PressureVCycles, NumCycles);
+
+    // Subtract the pressure gradient, pressure is zero outside the window to match the solver
+    const float* RESTRICT Pressure = PressureSolver.GetPressure();
+    ParallelFor(SizeZ, [this, &Target, Pressure](int32 z)
+    {
+        auto GetPressure = [this, Pressure](int32 X, int32 Y, int32 Z)
+        {
+            return IsValidIndex(X, Y, Z) ? Pressure[X + (Y + Z * SizeY) * SizeX] : 0.0f;
+        };
+
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            for (int32 x = 0; x < SizeX; ++x)
+            {
+                const FVector3f Gradient = 0.5f * FVector3f(
+                    GetPressure(x + 1, y, z) - GetPressure(x - 1, y, z),
+                    GetPressure(x, y + 1, z) - GetPressure(x, y - 1, z),
+                    GetPressure(x, y, z + 1) - GetPressure(x, y, z - 1));
+
+                const int32 Index = GetIndex(x, y, z);
+                Target.Set(Index, (Target.Get(Index) - Gradient) * GetOpenFactor(Index));
+            }
+        }
+    }, Flags);
+}
+
+template<typename ChannelsType>
+void UWindVectorField::ConfineVorticity(ChannelsType& Target, float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_VorticityConfinement);
+
+    VorticityConfinement.Resize(FIntVector(SizeX, SizeY, SizeZ));
+    SET_MEMORY_STAT(STAT_WindField_VorticityMemory, VorticityConfinement.GetAllocatedSize());
+
+    const EParallelForFlags Flags = bParallelSolve ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+    // Gathered into window order once, so the curl and gradient passes run on contiguous float rows whatever the
+    // storage layout, precision or ring offset
+    FWindVectorChannels& Channels = VorticityConfinement.GetChannels();
+    ParallelFor(SizeZ, [this, &Target, &Channels](int32 z)
+    {
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            int32 WindowIndex = (y + z * SizeY) * SizeX;
+            for (int32 x = 0; x < SizeX; ++x, ++WindowIndex)
+            {
+                Channels.Set(WindowIndex, Target.Get(GetIndex(x, y, z)));
+            }
+        }
+    }, Flags);
+
+    // Nothing to add, the channels still hold the gathered velocity
+    if (!VorticityConfinement.Compute(VorticityStrength, CellSize, DeltaTime, bParallelSolve))
+    {
+        return;
+    }
+
+    ParallelFor(SizeZ, [this, &Target, &Channels](int32 z)
+    {
+        for (int32 y = 0; y < SizeY; ++y)
+        {
+            int32 WindowIndex = (y + z * SizeY) * SizeX;
+            for (int32 x = 0; x < SizeX; ++x, ++WindowIndex)
+            {
+                const int32 Index = GetIndex(x, y, z);
+                Target.Set(Index, Target.Get(Index) + Channels.Get(WindowIndex) * GetOpenFactor(Index));
+            }
+        }
+    }, Flags);
+}
+
+FVector3f UWindVectorField::GetAmbientWind() const
+{
+    // What the dense grid settles to without turbulence, Force / WindDecayRate
+    return FVector3f(WindBias * WindScale / WindDecayRate);
+}
+
+// Picks the finest view whose window holds the point, anything beyond the outermost level clamps against it
+static const FWindGridView& PickClipmapView(TConstArrayView<FWindGridView> Views, const FVector3f& WorldPos)
+{
+    for (const FWindGridView& View : Views)
+    {
+        if (View.ContainsWorldPosition(WorldPos))
+        {
+            return View;
+        }
+    }
+    return Views.Last();
+}
+
+void UWindVectorField::SyncClipmapLevels()
+{
+    // Sparse fields are already unbounded, clipmaps only apply to the dense grid
+    const int32 NumCoarseLevels = IsSparse() ? 0 : FMath::Clamp(NumClipmapLevels, 1, 6) - 1;
+    if (ClipmapLevels.Num() == NumCoarseLevels)
+    {
+        return;
+    }
+
+    for (UWindVectorField* Level : ClipmapLevels)
+    {
+        if (Level)
+        {
+            Level->WaitForAsyncUpdate();
+        }
+    }
+    ClipmapLevels.Reset();
+    ClipmapPendingDeltaTime.Reset();
+    ClipmapFrameCounter = 0;
+
+    for (int32 LevelIndex = 0; LevelIndex < NumCoarseLevels; ++LevelIndex)
+    {
+        UWindVectorField* Level = NewObject<UWindVectorField>(this, NAME_None, RF_Transient);
+
+        // Same cell count at twice the cell size per level, so each level doubles the covered extent
+        Level->SizeX = SizeX;
+        Level->SizeY = SizeY;
+        Level->SizeZ = SizeZ;
+        Level->CellSize = CellSize * (1 << (LevelIndex + 1));
+        // A fixed level 0 keeps its coarser levels fixed too, centred on the same point
+        Level->bScrollWithTarget = bScrollWithTarget;
+        if (!bScrollWithTarget)
+        {
+            Level->FieldOrigin = GetClipmapLevelOrigin(Level);
+        }
+        Level->ScrollTarget = ScrollTarget;
+        Level->VelocityPrecision = VelocityPrecision;
+        Level->QuantizationMaxSpeed = QuantizationMaxSpeed;
+        Level->GridLayout = GridLayout;
+        ConfigureClipmapLevel(Level, LevelIndex);
+        if (bAsyncInitialize)
+        {
+            // Sampling skips a level until it is ready, the finer and coarser ones answer meanwhile
+            Level->InitializeAsync();
+        }
+        else
+        {
+            Level->Initialize();
+        }
+
+        ClipmapLevels.Add(Level);
+        ClipmapPendingDeltaTime.Add(0.0f);
+    }
+}
+
+// Static levels share level 0's centre. Their views, injections and solid cells all address from this origin.
+FVector UWindVectorField::GetClipmapLevelOrigin(const UWindVectorField* Level) const
+{
+    const FVector Extent(SizeX, SizeY, SizeZ);
+    return FieldOrigin + Extent * (CellSize - Level->CellSize) * 0.5f;
+}
+
+void UWindVectorField::ConfigureClipmapLevel(UWindVectorField* Level, int32 LevelIndex) const
+{
+    // Noise is evaluated per cell, scale it with the cell size so every level sees the same world-space turbulence
+    Level->WindNoiseFrequency = WindNoiseFrequency;
+    Level->WindNoiseSeed = WindNoiseSeed;
+    Level->WindScale = WindScale;
+    Level->WindBias = WindBias;
+    Level->TurbulenceStrength = TurbulenceStrength;
+    Level->NoiseScale = NoiseScale * (1 << (LevelIndex + 1));
+    Level->bUseObstacleMask = bUseObstacleMask;
+    Level->ObstacleMask = ObstacleMask;
+    Level->bForceFieldDirty = true;
+
+    ApplyClipmapSolverSettings(Level, LevelIndex);
+}
+
+void UWindVectorField::ApplyClipmapSolverSettings(UWindVectorField* Level, int32 LevelIndex) const
+{
+    Level->bParallelSolve = bParallelSolve;
+    Level->SolverMode = SolverMode;
+    Level->bAsyncSimulation = bAsyncSimulation;
+    Level->AdvectionScheme = AdvectionScheme;
+    Level->bSkipQuiescentTiles = bSkipQuiescentTiles;
+    Level->QuiescenceThreshold = QuiescenceThreshold;
+    Level->QuiescenceSteps = QuiescenceSteps;
+    Level->bProjectIncompressible = bProjectIncompressible;
+    Level->PressureBudgetMicroseconds = PressureBudgetMicroseconds;
+    Level->MaxPressureVCycles = MaxPressureVCycles;
+    Level->VorticityStrength = VorticityStrength;
+
+    // Fixed-rate levels stagger through their rate rather than through skipped Updates
+    Level->bFixedTimestep = bFixedTimestep;
+    Level->SimulationRate = bStaggerClipmapUpdates ? SimulationRate / (1 << (LevelIndex + 1)) : SimulationRate;
+    Level->MaxSubstepsPerUpdate = MaxSubstepsPerUpdate;
+    Level->bAsyncInitialize = bAsyncInitialize;
+    Level->WarmUpSteps = WarmUpSteps;
+}
+
+void UWindVectorField::UpdateClipmapLevels(float DeltaTime)
+{
+    SyncClipmapLevels();
+
+    if (ClipmapLevels.Num() == 0)
+    {
+        return;
+    }
+
+    ++ClipmapFrameCounter;
+
+    for (int32 LevelIndex = 0; LevelIndex < ClipmapLevels.Num(); ++LevelIndex)
+    {
+        UWindVectorField* Level = ClipmapLevels[LevelIndex];
+        if (!Level)
+        {
+            continue;
+        }
+
+        ApplyClipmapSolverSettings(Level, LevelIndex);
+
+        // Coarse cells need longer to cross, so level N gets away with a step every 2^N frames
+        ClipmapPendingDeltaTime[LevelIndex] += DeltaTime;
+        const uint32 Interval = (bStaggerClipmapUpdates && !bFixedTimestep) ? (1u << (LevelIndex + 1)) : 1u;
+        if (ClipmapFrameCounter % Interval != 0)
+        {
+            continue;
+        }
+
+        Level->Update(ClipmapPendingDeltaTime[LevelIndex]);
+        ClipmapPendingDeltaTime[LevelIndex] = 0.0f;
+        INC_DWORD_STAT(STAT_WindField_ClipmapLevelSteps);
+    }
+}
+
+void UWindVectorField::PropagateForceParameters()
+{
+    for (int32 LevelIndex = 0; LevelIndex < ClipmapLevels.Num(); ++LevelIndex)
+    {
+        UWindVectorField* Level = ClipmapLevels[LevelIndex];
+        if (Level && !Level->DeferUntilReady([this, Level, LevelIndex]() { ConfigureClipmapLevel(Level, LevelIndex); }))
+        {
+            ConfigureClipmapLevel(Level, LevelIndex);
+        }
+    }
+}
+
+void UWindVectorField::GetClipmapViews(const FWindGridView& FinestView, TArray<FWindGridView, TInlineAllocator<8>>& OutViews) const
+{
+    OutViews.Add(FinestView);
+    for (const UWindVectorField* Level : ClipmapLevels)
+    {
+        const FWindGridView LevelView = Level ? Level->GetGridView() : FWindGridView();
+        if (LevelView.IsValid())
+        {
+            OutViews.Add(LevelView);
+        }
+    }
+}
+
+FWindGridView UWindVectorField::MakePredictionView(const FWindGridView& Front) const
+{
+    // Same geometry and ring layout as the front buffer
+    FWindGridView Predicted = Front;
+    Predicted.X = AdvectScratch.X.GetData();
+    Predicted.Y = AdvectScratch.Y.GetData();
+    Predicted.Z = AdvectScratch.Z.GetData();
+    Predicted.Precision = EWindVelocityPrecision::Float32;
+    Predicted.DecodeScale = 1.0f;
+    return Predicted;
+}
+
+template<EWindVelocityPrecision Precision>
+void UWindVectorField::PredictBlock(const FWindGridView& Front, const FIntVector& Min, const FIntVector& Max, float DeltaTime, bool bAdvect)
+{
+    for (int sz = Min.Z; sz < Max.Z; ++sz)
+    {
+        const int z = FWindGridView::WrapOnce(sz - RingOffset.Z + SizeZ, SizeZ);
+        for (int sy = Min.Y; sy < Max.Y; ++sy)
+        {
+            const int y = FWindGridView::WrapOnce(sy - RingOffset.Y + SizeY, SizeY);
+            for (int sx = Min.X; sx < Max.X; ++sx)
+            {
+                const int x = FWindGridView::WrapOnce(sx - RingOffset.X + SizeX, SizeX);
+                const int idx = FWindGridView::ComputeStorageIndex(GridLayout, sx, sy, sz, SizeX, SizeY);
+                const FVector3f currentVelocity = Front.GetCellAs<Precision>(idx);
+
+                // Plain semi-Lagrangian step, cells that are not advected (sleeping tiles) predict no change
+                if (bAdvect)
+                {
+                    const FVector3f worldPos = FVector3f(x, y, z) * CellSize;
+                    const FVector3f prevPos = worldPos - currentVelocity * DeltaTime;
+                    AdvectScratch.Set(idx, Front.SampleGrid(prevPos / CellSize));
+                }
+                else
+                {
+                    AdvectScratch.Set(idx, currentVelocity);
+                }
+            }
+        }
+    }
+}
+
+template<EWindVelocityPrecision Precision>
+float UWindVectorField::StepFusedBlock(const FWindGridView& Front, const FWindGridView* Predicted, const FIntVector& Min, const FIntVector& Max, float DeltaTime, float Decay)
+{
+    const float* RESTRICT ForceX = Force.X.GetData();
+    const float* RESTRICT ForceY = Force.Y.GetData();
+    const float* RESTRICT ForceZ = Force.Z.GetData();
+    float* RESTRICT OutX = BackVelocity.X.GetData();
+    float* RESTRICT OutY = BackVelocity.Y.GetData();
+    float* RESTRICT OutZ = BackVelocity.Z.GetData();
+
+    float MaxChangeSq = 0.0f;
+
+    // Min/Max are storage coordinates so the block walks memory in order, the backtrace needs window-local ones
+    for (int sz = Min.Z; sz < Max.Z; ++sz)
+    {
+        const int z = FWindGridView::WrapOnce(sz - RingOffset.Z + SizeZ, SizeZ);
+        for (int sy = Min.Y; sy < Max.Y; ++sy)
+        {
+            const int y = FWindGridView::WrapOnce(sy - RingOffset.Y + SizeY, SizeY);
+            for (int sx = Min.X; sx < Max.X; ++sx)
+            {
+                const int x = FWindGridView::WrapOnce(sx - RingOffset.X + SizeX, SizeX);
+                const int idx = FWindGridView::ComputeStorageIndex(GridLayout, sx, sy, sz, SizeX, SizeY);
+                const FVector3f currentVelocity = Front.GetCellAs<Precision>(idx);
+
+                // Backtrace and sample exactly like Advect
+                const FVector3f worldPos = FVector3f(x, y, z) * CellSize;
+                const FVector3f prevPos = worldPos - currentVelocity * DeltaTime;
+                FVector3f advectedVelocity;
+                if (Predicted)
+                {
+                    // MacCormack, carry the prediction forward to this cell again and correct by half the round-trip error
+                    const FVector3f Forward = Predicted->GetCellAs<EWindVelocityPrecision::Float32>(idx);
+                    const FVector3f RoundTrip = Predicted->SampleGrid((worldPos + currentVelocity * DeltaTime) / CellSize);
+
+                    // The limiter keeps the corrected value within the cells it was interpolated from, or it overshoots
+                    FVector3f CornerMin, CornerMax;
+                    Front.GetCornerBounds(prevPos / CellSize, CornerMin, CornerMax);
+                    advectedVelocity = (Forward + 0.5f * (currentVelocity - RoundTrip)).BoundToBox(CornerMin, CornerMax);
+                }
+                else
+                {
+                    advectedVelocity = Front.SampleGrid(prevPos / CellSize);
+                }
+
+                // Decay and force accumulation while the cell is still in registers. Solid cells decay to zero in one
+                // step and have no force, so walls stay calm.
+                const float CellDecay = Decay * GetOpenFactor(idx);
+                const FVector3f Result(
+                    advectedVelocity.X * CellDecay + ForceX[idx] * DeltaTime,
+                    advectedVelocity.Y * CellDecay + ForceY[idx] * DeltaTime,
+                    advectedVelocity.Z * CellDecay + ForceZ[idx] * DeltaTime);
+
+                if constexpr (Precision == EWindVelocityPrecision::Float32)
+                {
+                    OutX[idx] = Result.X;
+                    OutY[idx] = Result.Y;
+                    OutZ[idx] = Result.Z;
+                }
+                else
+                {
+                    PackedBackVelocity.Set(idx, Result);
+                }
+
+                MaxChangeSq = FMath::Max(MaxChangeSq, FVector3f::DistSquared(Result, currentVelocity));
+            }
+        }
+    }
+    return MaxChangeSq;
+}
+
+// Carries cells over unchanged, raw elements so packed grids are not re-encoded
+template<typename ChannelsType>
+static void CopyBlock(ChannelsType& Dst, const ChannelsType& Src, EWindGridLayout Layout, const FIntVector& Min, const FIntVector& Max, int32 SizeX, int32 SizeY)
+{
+    for (int32 sz = Min.Z; sz < Max.Z; ++sz)
+    {
+        for (int32 sy = Min.Y; sy < Max.Y; ++sy)
+        {
+            for (int32 sx = Min.X; sx < Max.X; ++sx)
+            {
+                const int32 Index = FWindGridView::ComputeStorageIndex(Layout, sx, sy, sz, SizeX, SizeY);
+                Dst.X[Index] = Src.X[Index];
+                Dst.Y[Index] = Src.Y[Index];
+                Dst.Z[Index] = Src.Z[Index];
+            }
+        }
+    }
+}
+
+void UWindVectorField::EnsureActivityTiles()
+{
+    if (!bSkipQuiescentTiles)
+    {
+        ActivityTiles.Empty();
+        ActivityTileCounts = FIntVector::ZeroValue;
+        NumActiveTiles = 0;
+        QuiescentStepCount = 0;
+        return;
+    }
+
+    const int32 TileMask = (1 << ActivityTileShift) - 1;
+    const FIntVector Counts(
+        (SizeX + TileMask) >> ActivityTileShift,
+        (SizeY + TileMask) >> ActivityTileShift,
+        (SizeZ + TileMask) >> ActivityTileShift);
+
+    // New tiles start awake, they have not seen a single step yet
+    if (Counts != ActivityTileCounts || ActivityTiles.Num() != Counts.X * Counts.Y * Counts.Z)
+    {
+        ActivityTileCounts = Counts;
+        ActivityTiles.Reset();
+        ActivityTiles.SetNum(Counts.X * Counts.Y * Counts.Z);
+        NumActiveTiles = ActivityTiles.Num();
+        QuiescentStepCount = 0;
+    }
+}
+
+void UWindVectorField::StepActiveTiles(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_FusedStep);
+
+    const FWindGridView Front = MakeGridView(false);
+    const float Decay = GetDecayFactor(DeltaTime);
+    const int32 SleepAfterSteps = FMath::Max(QuiescenceSteps, 1);
+    const bool bPacked = IsPacked();
+    const EParallelForFlags Flags = bParallelSolve ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+    // Woken tiles are not counted in NumActiveTiles until the end of the step
+    int32 NumSteppedTiles = 0;
+    for (int32 TileIndex = 0; TileIndex < ActivityTiles.Num(); ++TileIndex)
+    {
+        if (ActivityTiles[TileIndex].QuietSteps < SleepAfterSteps)
+        {
+            ++NumSteppedTiles;
+
+            // Tile bounds are storage cells, the slices are in window order
+            FIntVector Min, Max;
+            GetActivityTileBounds(TileIndex, Min, Max);
+            for (int32 StorageZ = Min.Z; StorageZ < Max.Z; ++StorageZ)
+            {
+                DirtySlices[FWindGridView::WrapOnce(StorageZ - RingOffset.Z + SizeZ, SizeZ)] = true;
+            }
+        }
+    }
+
+    // The corrector of an active tile may sample the prediction inside a sleeping neighbour, so every tile predicts
+    const bool bMacCormack = UsesMacCormack();
+    const FWindGridView Predicted = MakePredictionView(Front);
+    if (bMacCormack)
+    {
+        ParallelFor(ActivityTiles.Num(), [this, &Front, DeltaTime, SleepAfterSteps](int32 TileIndex)
+        {
+            FIntVector Min, Max;
+            GetActivityTileBounds(TileIndex, Min, Max);
+            const bool bAdvect = ActivityTiles[TileIndex].QuietSteps < SleepAfterSteps;
+            switch (Front.Precision)
+            {
+            case EWindVelocityPrecision::Half:  PredictBlock<EWindVelocityPrecision::Half>(Front, Min, Max, DeltaTime, bAdvect); break;
+            case EWindVelocityPrecision::Int16: PredictBlock<EWindVelocityPrecision::Int16>(Front, Min, Max, DeltaTime, bAdvect); break;
+            default:                            PredictBlock<EWindVelocityPrecision::Float32>(Front, Min, Max, DeltaTime, bAdvect); break;
+            }
+        }, Flags);
+    }
+
+    // Tiles only read the front buffer and write their own back buffer cells, so they are independent
+    const FWindGridView* PredictedPtr = bMacCormack ? &Predicted : nullptr;
+    ParallelFor(ActivityTiles.Num(), [this, &Front, PredictedPtr, DeltaTime, Decay, SleepAfterSteps, bPacked](int32 TileIndex)
+    {
+        FActivityTile& Tile = ActivityTiles[TileIndex];
+        FIntVector Min, Max;
+        GetActivityTileBounds(TileIndex, Min, Max);
+
+        // A sleeping tile only has to be carried over into the buffer that becomes the front
+        if (Tile.QuietSteps >= SleepAfterSteps)
+        {
+            if (bPacked)
+            {
+                CopyBlock(PackedBackVelocity, PackedVelocity, GridLayout, Min, Max, SizeX, SizeY);
+            }
+            else
+            {
+                CopyBlock(BackVelocity, Velocity, GridLayout, Min, Max, SizeX, SizeY);
+            }
+            return;
+        }
+
+        switch (Front.Precision)
+        {
+        case EWindVelocityPrecision::Half:  Tile.MaxChangeSq = StepFusedBlock<EWindVelocityPrecision::Half>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        case EWindVelocityPrecision::Int16: Tile.MaxChangeSq = StepFusedBlock<EWindVelocityPrecision::Int16>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        default:                            Tile.MaxChangeSq = StepFusedBlock<EWindVelocityPrecision::Float32>(Front, PredictedPtr, Min, Max, DeltaTime, Decay); break;
+        }
+    }, Flags);
+
+    // Only a step that ran no tile at all leaves the grid exactly as it was
+    bStepChangedGrid = NumSteppedTiles > 0;
+    INC_DWORD_STAT_BY(STAT_WindField_QuiescentTilesSkipped, ActivityTiles.Num() - NumSteppedTiles);
+
+    UpdateTileActivity();
+}
+
+void UWindVectorField::UpdateTileActivity()
+{
+    const float ThresholdSq = FMath::Square(QuiescenceThreshold);
+    const int32 SleepAfterSteps = FMath::Max(QuiescenceSteps, 1);
+
+    TArray<int32, TInlineAllocator<64>> ChangingTiles;
+    for (int32 TileIndex = 0; TileIndex < ActivityTiles.Num(); ++TileIndex)
+    {
+        FActivityTile& Tile = ActivityTiles[TileIndex];
+        if (Tile.QuietSteps >= SleepAfterSteps)
+        {
+            continue;
+        }
+
+        if (Tile.MaxChangeSq > ThresholdSq)
+        {
+            ChangingTiles.Add(TileIndex);
+        }
+        else
+        {
+            ++Tile.QuietSteps;
+        }
+    }
+
+    // Wind moving through a changing tile reaches the cells next to it within a step, they have to be solved too
+    for (const int32 TileIndex : ChangingTiles)
+    {
+        WakeTileNeighbourhood(TileIndex);
+    }
+
+    NumActiveTiles = 0;
+    for (const FActivityTile& Tile : ActivityTiles)
+    {
+        NumActiveTiles += Tile.QuietSteps < SleepAfterSteps ? 1 : 0;
+    }
+
+    SET_DWORD_STAT(STAT_WindField_ActiveTiles, NumActiveTiles);
+    SET_FLOAT_STAT(STAT_WindField_ActiveTilePercent, ActivityTiles.Num() > 0 ? 100.0f * NumActiveTiles / ActivityTiles.Num() : 0.0f);
+}
+
+void UWindVectorField::GetActivityTileBounds(int32 TileIndex, FIntVector& OutMin, FIntVector& OutMax) const
+{
+    const int32 TileX = TileIndex % ActivityTileCounts.X;
+    const int32 TileY = (TileIndex / ActivityTileCounts.X) % ActivityTileCounts.Y;
+    const int32 TileZ = TileIndex / (ActivityTileCounts.X * ActivityTileCounts.Y);
+
+    // Edge tiles are cut off at the grid size, the storage padding of a Tiled layout is never solved
+    OutMin = FIntVector(TileX, TileY, TileZ) * (1 << ActivityTileShift);
+    OutMax = FIntVector(
+        FMath::Min(OutMin.X + (1 << ActivityTileShift), SizeX),
+        FMath::Min(OutMin.Y + (1 << ActivityTileShift), SizeY),
+        FMath::Min(OutMin.Z + (1 << ActivityTileShift), SizeZ));
+}
+
+void UWindVectorField::WakeTileNeighbourhood(int32 TileIndex)
+{
+    const FIntVector& Counts = ActivityTileCounts;
+    const int32 TileX = TileIndex % Counts.X;
+    const int32 TileY = (TileIndex / Counts.X) % Counts.Y;
+    const int32 TileZ = TileIndex / (Counts.X * Counts.Y);
+
+    // Storage wraps around with the ring buffer, the tile across the seam is a window neighbour too
+    for (int32 DZ = -1; DZ <= 1; ++DZ)
+    {
+        const int32 Z = FWindGridView::WrapAny(TileZ + DZ, Counts.Z);
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            const int32 Y = FWindGridView::WrapAny(TileY + DY, Counts.Y);
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const int32 X = FWindGridView::WrapAny(TileX + DX, Counts.X);
+                ActivityTiles[X + (Y + Z * Counts.Y) * Counts.X].QuietSteps = 0;
+            }
+        }
+    }
+}
+
+void UWindVectorField::WakeTiles(const FIntVector& Min, const FIntVector& Max)
+{
+    if (ActivityTiles.Num() == 0)
+    {
+        return;
+    }
+
+    // The region is a box in window space, so its storage tiles are the product of the tiles it touches per axis
+    auto GatherAxisTiles = [](int32 AxisMin, int32 AxisMax, int32 Ring, int32 Size, TArray<int32, TInlineAllocator<32>>& OutTiles)
+    {
+        for (int32 Cell = AxisMin; Cell <= AxisMax; ++Cell)
+        {
+            OutTiles.AddUnique(FWindGridView::WrapOnce(Cell + Ring, Size) >> ActivityTileShift);
+        }
+    };
+
+    TArray<int32, TInlineAllocator<32>> TilesX, TilesY, TilesZ;
+    GatherAxisTiles(Min.X, Max.X, RingOffset.X, SizeX, TilesX);
+    GatherAxisTiles(Min.Y, Max.Y, RingOffset.Y, SizeY, TilesY);
+    GatherAxisTiles(Min.Z, Max.Z, RingOffset.Z, SizeZ, TilesZ);
+
+    for (const int32 TileZ : TilesZ)
+    {
+        for (const int32 TileY : TilesY)
+        {
+            for (const int32 TileX : TilesX)
+            {
+                WakeTileNeighbourhood(TileX + (TileY + TileZ * ActivityTileCounts.Y) * ActivityTileCounts.X);
+            }
+        }
+    }
+
+    bStepChangedGrid = true;
+    QuiescentStepCount = 0;
+}
+
+void UWindVectorField::MarkSlicesDirty(int32 MinZ, int32 MaxZ)
+{
+    if (DirtySlices.Num() != SizeZ)
+    {
+        ResetDirtySlices();
+    }
+    for (int32 z = FMath::Max(MinZ, 0); z <= FMath::Min(MaxZ, SizeZ - 1); ++z)
+    {
+        DirtySlices[z] = true;
+    }
+}
+
+void UWindVectorField::BumpGridVersion(const TBitArray<>* ChangedSlices)
+{
+    // Filed before the version is published, a reader that sees the version finds its slices
+    FScopeLock Lock(&GridChangeLock);
+    const uint64 Version = GridVersion.load(std::memory_order_relaxed) + 1;
+    FGridChange& Change = GridChanges[Version % GridChangeHistory];
+    Change.Version = Version;
+    if (ChangedSlices && ChangedSlices->Num() == SizeZ)
+    {
+        Change.DirtySlices = *ChangedSlices;
+    }
+    else
+    {
+        Change.DirtySlices.Empty();
+    }
+    GridVersion.store(Version, std::memory_order_release);
+}
+
+bool UWindVectorField::GetDirtySlices(uint64 SinceVersion, TBitArray<>& OutSlices) const
+{
+    FScopeLock Lock(&GridChangeLock);
+    const uint64 Version = GridVersion.load(std::memory_order_relaxed);
+    if (SinceVersion == 0 || SinceVersion > Version || Version - SinceVersion > GridChangeHistory || SizeZ <= 0)
+    {
+        return false;
+    }
+
+    OutSlices.Init(false, SizeZ);
+    for (uint64 ChangeVersion = SinceVersion + 1; ChangeVersion <= Version; ++ChangeVersion)
+    {
+        const FGridChange& Change = GridChanges[ChangeVersion % GridChangeHistory];
+        if (Change.Version != ChangeVersion || Change.DirtySlices.Num() != SizeZ)
+        {
+            return false;
+        }
+        OutSlices.CombineWithBitwiseOR(Change.DirtySlices, EBitwiseOperatorFlags::MinSize);
+    }
+    return true;
+}
+
+void UWindVectorField::WakeAllTiles()
+{
+    for (FActivityTile& Tile : ActivityTiles)
+    {
+        Tile.QuietSteps = 0;
+    }
+    NumActiveTiles = ActivityTiles.Num();
+    bStepChangedGrid = true;
+    QuiescentStepCount = 0;
+}
+
+bool UWindVectorField::IsQuiescent() const
+{
+    // One unchanged step is enough, sleeping tiles copy their cells so the previous step holds the same wind
+    if (!IsReady() || IsPlayingSequence())
+    {
+        return false;
+    }
+    FReadScopeLock ReadLock(PublishLock);
+    return ActivityTiles.Num() > 0 && QuiescentStepCount > 0;
+}
+
+void UWindVectorField::ApplyForceField(float DeltaTime)
+{
+    const int32 NumCells = BackVelocity.Num();
+
+    // Per channel multiply-add, kept as flat loops so they vectorize
+    const FWindVectorChannels::FChannel* ForceChannels[3] = { &Force.X, &Force.Y, &Force.Z };
+    FWindVectorChannels::FChannel* VelocityChannels[3] = { &BackVelocity.X, &BackVelocity.Y, &BackVelocity.Z };
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const float* RESTRICT Src = ForceChannels[Axis]->GetData();
+        float* RESTRICT Dst = VelocityChannels[Axis]->GetData();
+        for (int32 Index = 0; Index < NumCells; ++Index)
+        {
+            Dst[Index] += Src[Index] * DeltaTime;
+        }
+    }
+
+    // Three noise lookups per cell that the cache spared us this frame
+    INC_DWORD_STAT_BY(STAT_WindField_NoiseEvaluationsSaved, NumCells * 3);
+}
+
+void UWindVectorField::RebuildForceField()
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_RebuildForceField);
+
+    Noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    Noise.SetFrequency(WindNoiseFrequency);
+    Noise.SetSeed(WindNoiseSeed);
+
+    Force.SetNumZeroed(GetStorageCellCount());
+    SolidCells.Init(0, (GetStorageCellCount() + 63) / 64);
+
+    for (int Z = 0; Z < SizeZ; ++Z)
+    {
+        for (int Y = 0; Y < SizeY; ++Y)
+        {
+            for (int X = 0; X < SizeX; ++X)
+            {
+                const int32 Index = GetIndex(X, Y, Z);
+                const bool bSolid = IsObstacleCell(X, Y, Z);
+                SetSolidCell(Index, bSolid);
+                Force.Set(Index, bSolid ? FVector3f::ZeroVector : ComputeForceAtCell(WindowOriginCell + FIntVector(X, Y, Z)));
+            }
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_WindField_NoiseEvaluations, Force.Num() * 3);
+
+    // Every cell is pushed towards a new equilibrium
+    WakeAllTiles();
+
+    bForceFieldDirty = false;
+    bSolidCellsDirty = false;
+}
+
+void UWindVectorField::ResampleSolidCells()
+{
+    for (int Z = 0; Z < SizeZ; ++Z)
+    {
+        for (int Y = 0; Y < SizeY; ++Y)
+        {
+            for (int X = 0; X < SizeX; ++X)
+            {
+                const int32 Index = GetIndex(X, Y, Z);
+                const bool bSolid = IsObstacleCell(X, Y, Z);
+                if (bSolid == (GetOpenFactor(Index) == 0.0f))
+                {
+                    continue;
+                }
+
+                // Solid cells carry no force, only the flipped cell's entry follows its new state
+                SetSolidCell(Index, bSolid);
+                Force.Set(Index, bSolid ? FVector3f::ZeroVector : ComputeForceAtCell(WindowOriginCell + FIntVector(X, Y, Z)));
+                WakeTiles(FIntVector(X, Y, Z), FIntVector(X, Y, Z));
+            }
+        }
+    }
+
+    bSolidCellsDirty = false;
+}
+
+bool UWindVectorField::IsObstacleCell(int X, int Y, int Z) const
+{
+    // Tested at the cell centre, the same point injections measure their falloff from
+    return bUseObstacleMask && ObstacleMask.IsSolidAt(FieldOrigin + (FVector(X, Y, Z) + 0.5f) * CellSize);
+}
+
+void UWindVectorField::SetSolidCell(int32 Index, bool bSolid)
+{
+    const uint64 Bit = uint64(1) << (Index & 63);
+    SolidCells[Index >> 6] = bSolid ? (SolidCells[Index >> 6] | Bit) : (SolidCells[Index >> 6] & ~Bit);
+}
+
+void UWindVectorField::BakeObstacleMask(const UObject* WorldContextObject)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+    if (!World)
+    {
+        return;
+    }
+
+    const FBox Bounds = ObstacleBakeBounds.IsValid
+        ? ObstacleBakeBounds
+        : FBox(FieldOrigin, FieldOrigin + FVector(SizeX, SizeY, SizeZ) * CellSize);
+
+    WaitForAsyncUpdate();
+    ObstacleMask.Bake(World, Bounds, CellSize, ObstacleObjectType);
+
+    // The solid bits are resampled along with the force field
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+    MarkPackageDirty();
+}
+
+void UWindVectorField::ClearObstacleMask()
+{
+    WaitForAsyncUpdate();
+    ObstacleMask.Reset();
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+    MarkPackageDirty();
+}
+
+#if WITH_EDITOR
+void UWindVectorField::BakeObstacleMaskFromEditorWorld()
+{
+    BakeObstacleMask(GEditor ? GEditor->GetEditorWorldContext().World() : nullptr);
+}
+#endif
+
+FVector3f UWindVectorField::ComputeForceAtCell(const FIntVector& Cell) const
+{
+    const int X = Cell.X;
+    const int Y = Cell.Y;
+    const int Z = Cell.Z;
+
+    // Sample noise for turbulence
+    float TurbX = Noise.GetNoise((float)X * NoiseScale, (float)Y * NoiseScale, (float)Z * NoiseScale);
+    float TurbY = Noise.GetNoise((float)X * NoiseScale + 1000, (float)Y * NoiseScale + 1000, (float)Z * NoiseScale + 1000);
+    float TurbZ = Noise.GetNoise((float)X * NoiseScale + 2000, (float)Y * NoiseScale + 2000, (float)Z * NoiseScale + 2000);
+
+    // Make turbulence gentle
+    FVector Turbulence = FVector(TurbX, TurbY, TurbZ) * TurbulenceStrength;
+
+    // Combine steady bias and turbulence
+    return FVector3f((WindBias + Turbulence) * WindScale);
+}
+
+void UWindVectorField::SetFieldOrigin(const FVector& NewFieldOrigin)
+{
+    // A scrolling grid owns its origin, it is snapped to the window every step
+    if (bScrollWithTarget)
+    {
+        return;
+    }
+
+    // The initialization task reads the origin for the solid cells and the steady-state key
+    if (DeferUntilReady([this, NewFieldOrigin]() { SetFieldOrigin(NewFieldOrigin); }))
+    {
+        return;
+    }
+
+    // The grid moved over different geometry, a shift within a cell keeps every solid bit
+    if (ObstacleMask.IsBaked() && CellSize > 0.0f)
+    {
+        const auto ToCell = [this](const FVector& Origin)
+        {
+            return FIntVector(FMath::FloorToInt(Origin.X / CellSize), FMath::FloorToInt(Origin.Y / CellSize), FMath::FloorToInt(Origin.Z / CellSize));
+        };
+        if (ToCell(NewFieldOrigin) != ToCell(FieldOrigin))
+        {
+            bSolidCellsDirty = true;
+        }
+    }
+    if (NewFieldOrigin != FieldOrigin)
+    {
+        {
+            FWriteScopeLock WriteLock(PublishLock);
+            FieldOrigin = NewFieldOrigin;
+        }
+
+        // Every view moved with it, copies made before are addressed in the old frame
+        BumpGridVersion();
+    }
+
+    for (UWindVectorField* Level : ClipmapLevels)
+    {
+        if (Level)
+        {
+            Level->SetFieldOrigin(GetClipmapLevelOrigin(Level));
+        }
+    }
+}
 
-UWindVectorField::UWindVectorField() 
+void UWindVectorField::SetScrollTarget(AActor* NewTarget)
 {
-    
+    ScrollTarget = NewTarget;
+    bScrollTargetSearchFailed = false;
+
+    for (UWindVectorField* Level : ClipmapLevels)
+    {
+        if (Level)
+        {
+            Level->SetScrollTarget(NewTarget);
+        }
+    }
 }
 
-void UWindVectorField::Initialize()
+bool UWindVectorField::GetScrollTargetLocation(FVector& OutLocation)
 {
-    if (bInitialized || SizeX <= 0 || SizeY <= 0 || SizeZ <= 0 || CellSize <= 0.0f)
+    if (!ScrollTarget.IsValid() && !bScrollTargetSearchFailed)
+    {
+        // Fall back to the Phoenix, looked up once rather than every frame
+        UWorld* World = GetWorld();
+        if (!World) return false;
+
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            if (*It && It->ActorHasTag("Phoenix"))
+            {
+                ScrollTarget = *It;
+                break;
+            }
+        }
+        bScrollTargetSearchFailed = !ScrollTarget.IsValid();
+    }
+
+    if (const AActor* Target = ScrollTarget.Get())
+    {
+        OutLocation = Target->GetActorLocation();
+        return true;
+    }
+    return false;
+}
+
+void UWindVectorField::UpdateScrollWindow()
+{
+    if (GetAllocatedCells() != GetStorageCellCount() || GetAllocatedCells() == 0)
     {
         return;
     }
 
-    VelocityGrid.SetNumZeroed(SizeX * SizeY * SizeZ);
+    if (!bScrollWithTarget)
+    {
+        // Back to a static grid, drop the ring addressing and start over from the force field
+        if (bScrollWindowValid)
+        {
+            FWriteScopeLock WriteLock(PublishLock);
+            WindowOriginCell = FIntVector::ZeroValue;
+            RingOffset = FIntVector::ZeroValue;
+            bScrollWindowValid = false;
+            ReseedRegion(FIntVector::ZeroValue, FIntVector(SizeX - 1, SizeY - 1, SizeZ - 1));
+        }
+        return;
+    }
 
-    Noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    Noise.SetFrequency(WindNoiseFrequency);
-    Noise.SetSeed(WindNoiseSeed);
+    FVector TargetLocation;
+    if (!GetScrollTargetLocation(TargetLocation))
+    {
+        return;
+    }
 
-    // Warmup wind field
-    const int WarmUpFrames = 10;
-    const float FixedDeltaTime = 0.016f;
-    for (int i = 0; i < WarmUpFrames; ++i)
+    // Snap in whole cells so the cells that stay inside the window keep their data untouched
+    const FIntVector NewOriginCell(
+        FMath::FloorToInt(TargetLocation.X / CellSize) - SizeX / 2,
+        FMath::FloorToInt(TargetLocation.Y / CellSize) - SizeY / 2,
+        FMath::FloorToInt(TargetLocation.Z / CellSize) - SizeZ / 2);
+
+    if (bScrollWindowValid && NewOriginCell == WindowOriginCell)
     {
-        Update(FixedDeltaTime);
+        return;
     }
 
-    bInitialized = true;
-}
+    FWriteScopeLock WriteLock(PublishLock);
 
-void UWindVectorField::PostLoad()
-{
-    Super::PostLoad();
+    const FIntVector Delta = NewOriginCell - WindowOriginCell;
+    const bool bFullReseed = !bScrollWindowValid
+        || FMath::Abs(Delta.X) >= SizeX || FMath::Abs(Delta.Y) >= SizeY || FMath::Abs(Delta.Z) >= SizeZ;
+
+    WindowOriginCell = NewOriginCell;
+    RingOffset = FIntVector(
+        FWindGridView::WrapAny(NewOriginCell.X, SizeX),
+        FWindGridView::WrapAny(NewOriginCell.Y, SizeY),
+        FWindGridView::WrapAny(NewOriginCell.Z, SizeZ));
+    FieldOrigin = FVector(WindowOriginCell) * CellSize;
+    bScrollWindowValid = true;
 
-    if (VelocityGrid.Num() == 0)
+    const FIntVector LastCell(SizeX - 1, SizeY - 1, SizeZ - 1);
+    if (bFullReseed)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PostLoad: Initializing wind field"));
-        Initialize();
+        ReseedRegion(FIntVector::ZeroValue, LastCell);
+        return;
     }
-}
 
-int UWindVectorField::GetIndex(int X, int Y, int Z) const
-{
-    return X + Y * SizeX + Z * SizeX * SizeY;
+    // Only the slabs that wrapped around to the leading edge hold stale data
+    if (Delta.X > 0) ReseedRegion(FIntVector(SizeX - Delta.X, 0, 0), LastCell);
+    if (Delta.X < 0) ReseedRegion(FIntVector::ZeroValue, FIntVector(-Delta.X - 1, LastCell.Y, LastCell.Z));
+    if (Delta.Y > 0) ReseedRegion(FIntVector(0, SizeY - Delta.Y, 0), LastCell);
+    if (Delta.Y < 0) ReseedRegion(FIntVector::ZeroValue, FIntVector(LastCell.X, -Delta.Y - 1, LastCell.Z));
+    if (Delta.Z > 0) ReseedRegion(FIntVector(0, 0, SizeZ - Delta.Z), LastCell);
+    if (Delta.Z < 0) ReseedRegion(FIntVector::ZeroValue, FIntVector(LastCell.X, LastCell.Y, -Delta.Z - 1));
 }
 
-bool UWindVectorField::IsValidIndex(int X, int Y, int Z) const
+void UWindVectorField::ReseedRegion(const FIntVector& Min, const FIntVector& Max)
 {
-    return X >= 0 && X < SizeX &&
-           Y >= 0 && Y < SizeY &&
-           Z >= 0 && Z < SizeZ;
-}
+    const int32 NumAllocatedCells = GetAllocatedCells();
+    if (Force.Num() != NumAllocatedCells)
+    {
+        Force.SetNumZeroed(NumAllocatedCells);
+    }
+    if (SolidCells.Num() != (NumAllocatedCells + 63) / 64)
+    {
+        SolidCells.Init(0, (NumAllocatedCells + 63) / 64);
+    }
 
-void UWindVectorField::Advect(float DeltaTime)
-{
-    // Temporary array to hold new velocities after advection
-    TArray<FVector> NewVelocityGrid;
-    NewVelocityGrid.SetNumZeroed(VelocityGrid.Num());
+    // The previous step shares the ring layout, reseed it too so interpolating readers see no stale slabs
+    const bool bPacked = IsPacked();
+    FWindVectorChannels& Previous = GetPreviousVelocity();
+    FWindPackedChannels& PackedPrevious = GetPreviousPackedVelocity();
+    const bool bSeedPrevious = bFixedTimestep
+        && (bPacked ? PackedPrevious.Num() : Previous.Num()) == NumAllocatedCells;
 
-    for (int z = 0; z < SizeZ; ++z)
+    for (int z = Min.Z; z <= Max.Z; ++z)
     {
-        for (int y = 0; y < SizeY; ++y)
+        for (int y = Min.Y; y <= Max.Y; ++y)
         {
-            for (int x = 0; x < SizeX; ++x)
+            for (int x = Min.X; x <= Max.X; ++x)
             {
-                int idx = GetIndex(x, y, z);
-                FVector currentVelocity = VelocityGrid[idx];
-
-                // Calculate where the wind came from (backtrace)
-                FVector worldPos = FVector(x, y, z) * CellSize;
-                FVector prevPos = worldPos - currentVelocity * DeltaTime;
+                const int idx = GetIndex(x, y, z);
+                const bool bSolid = IsObstacleCell(x, y, z);
+                SetSolidCell(idx, bSolid);
+                const FVector3f CellForce = bSolid ? FVector3f::ZeroVector : ComputeForceAtCell(WindowOriginCell + FIntVector(x, y, z));
 
-                // Convert prevPos to grid coords (from world coordinates)
-                FVector gridPos = prevPos / CellSize;
-
-                // Trilinear interpolation for velocity at prevPos
-                FVector advectedVelocity = SampleVelocityAtGridPosition(gridPos);
-
-                NewVelocityGrid[idx] = advectedVelocity;
+                // Start at the force/decay equilibrium instead of dead calm
+                Force.Set(idx, CellForce);
+                const FVector3f CellVelocity = CellForce / WindDecayRate;
+                if (bPacked)
+                {
+                    PackedVelocity.Set(idx, CellVelocity);
+                    if (bSeedPrevious)
+                    {
+                        PackedPrevious.Set(idx, CellVelocity);
+                    }
+                }
+                else
+                {
+                    Velocity.Set(idx, CellVelocity);
+                    if (bSeedPrevious)
+                    {
+                        Previous.Set(idx, CellVelocity);
+                    }
+                }
             }
         }
     }
 
-    VelocityGrid = NewVelocityGrid;
+    // Also wakes the old trailing edge, which sits next to the reseeded slab in storage and now clamps at the window
+    WakeTiles(Min, Max);
+
+    const int32 NumCells = (Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+    INC_DWORD_STAT_BY(STAT_WindField_ScrollReseededCells, NumCells);
+    INC_DWORD_STAT_BY(STAT_WindField_NoiseEvaluations, NumCells * 3);
 }
 
-void UWindVectorField::DecayVelocity(float DeltaTime)
+void UWindVectorField::SetWindBias(const FVector& NewWindBias)
 {
-    float decayRate = 1.0f; // Adjust this to control how fast wind slows down
-
-    for (FVector& vel : VelocityGrid)
+    if (DeferUntilReady([this, NewWindBias]() { SetWindBias(NewWindBias); }))
     {
-        vel *= FMath::Max(0.0f, 1.0f - decayRate * DeltaTime);
+        return;
     }
+
+    WindBias = NewWindBias;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
 }
 
-FVector const UWindVectorField::SampleVelocityAtGridPosition(const FVector& GridPos) const
+void UWindVectorField::SetWindScale(float NewWindScale)
 {
-    // Ensure grid in initialized
-    if (VelocityGrid.Num() == 0 || SizeX <= 1 || SizeY <= 1 || SizeZ <= 1)
+    if (DeferUntilReady([this, NewWindScale]() { SetWindScale(NewWindScale); }))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SampleVelocityAtGridPosition called with uninitialized or too small grid"));
-        return FVector::ZeroVector;
+        return;
     }
 
-    // GridPos components can be fractional
-    int x0 = FMath::FloorToInt(GridPos.X);
-    int y0 = FMath::FloorToInt(GridPos.Y);
-    int z0 = FMath::FloorToInt(GridPos.Z);
-
-    int x1 = x0 + 1;
-    int y1 = y0 + 1;
-    int z1 = z0 + 1;
+    WindScale = NewWindScale;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+}
 
-    // Clamp indices to enure they're within bounds
-    x0 = FMath::Clamp(x0, 0, SizeX - 1);
-    y0 = FMath::Clamp(y0, 0, SizeY - 1);
-    z0 = FMath::Clamp(z0, 0, SizeZ - 1);
+void UWindVectorField::SetTurbulenceStrength(float NewTurbulenceStrength)
+{
+    if (DeferUntilReady([this, NewTurbulenceStrength]() { SetTurbulenceStrength(NewTurbulenceStrength); }))
+    {
+        return;
+    }
 
-    x1 = FMath::Clamp(x1, 0, SizeX - 1);
-    y1 = FMath::Clamp(y1, 0, SizeY - 1);
-    z1 = FMath::Clamp(z1, 0, SizeZ - 1);
+    TurbulenceStrength = NewTurbulenceStrength;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+}
 
-    // Ensure all indices are still valid
-    auto SafeGet = [&](int X, int Y, int Z)
+void UWindVectorField::SetNoiseScale(float NewNoiseScale)
+{
+    if (DeferUntilReady([this, NewNoiseScale]() { SetNoiseScale(NewNoiseScale); }))
     {
-        return IsValidIndex(X, Y, Z) ? VelocityGrid[GetIndex(X, Y, Z)] : FVector::ZeroVector;
-    };
-
-    // Get Velocity at corners
-    FVector c000 = SafeGet(x0, y0, z0);
-    FVector c100 = SafeGet(x1, y0, z0);
-    FVector c010 = SafeGet(x0, y1, z0);
-    FVector c110 = SafeGet(x1, y1, z0);
-    FVector c001 = SafeGet(x0, y0, z1);
-    FVector c101 = SafeGet(x1, y0, z1);
-    FVector c011 = SafeGet(x0, y1, z1);
-    FVector c111 = SafeGet(x1, y1, z1);
+        return;
+    }
 
-    // Fractional distance within the cell
-    float sx = GridPos.X - x0;
-    float sy = GridPos.Y - y0;
-    float sz = GridPos.Z - z0;
+    NoiseScale = NewNoiseScale;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+}
 
-    // Interpolate along X
-    FVector c00 = FMath::Lerp(c000, c100, sx);
-    FVector c10 = FMath::Lerp(c010, c110, sx);
-    FVector c01 = FMath::Lerp(c001, c101, sx);
-    FVector c11 = FMath::Lerp(c011, c111, sx);
+void UWindVectorField::SetWindNoiseSeed(float NewWindNoiseSeed)
+{
+    if (DeferUntilReady([this, NewWindNoiseSeed]() { SetWindNoiseSeed(NewWindNoiseSeed); }))
+    {
+        return;
+    }
 
-    // Interpolate along Y
-    FVector c0 = FMath::Lerp(c00, c10, sy);
-    FVector c1 = FMath::Lerp(c01, c11, sy);
+    WindNoiseSeed = NewWindNoiseSeed;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+}
 
-    // Interpolate along Z
-    FVector c = FMath::Lerp(c0, c1, sz);
+void UWindVectorField::SetWindNoiseFrequency(float NewWindNoiseFrequency)
+{
+    if (DeferUntilReady([this, NewWindNoiseFrequency]() { SetWindNoiseFrequency(NewWindNoiseFrequency); }))
+    {
+        return;
+    }
 
-    //UE_LOG(LogTemp, Warning, TEXT("SampleWindAtPosition called on initialized field. Asset name: %s"), *GetNameSafe(this));
+    WindNoiseFrequency = NewWindNoiseFrequency;
+    bForceFieldDirty = true;
+    PropagateForceParameters();
+}
 
-    return c;
+bool UWindVectorField::IsForceFieldProperty(FName PropertyName)
+{
+    return PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, NoiseScale)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, WindNoiseSeed)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, WindNoiseFrequency)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, TurbulenceStrength)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, WindBias)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, WindScale)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UWindVectorField, bUseObstacleMask);
 }
 
-void UWindVectorField::Update(float DeltaTime)
+void UWindVectorField::InjectWindAtPosition(const FVector& WorldPos, const FVector& VelocityToInject, float Radius)
 {
-    if (VelocityGrid.Num() == 0)
+    // Playback is pre-simulated, disturbances would only pile up in the paused grid
+    if (IsPlayingSequence())
     {
-        UE_LOG(LogTemp, Error, TEXT("[WindField] Update called before Initialize! Skipping update."));
         return;
     }
 
-    Advect(DeltaTime);
-    DecayVelocity(DeltaTime);
+    // Coarser levels get the same disturbance, each clamps it to its own window
+    for (UWindVectorField* Level : ClipmapLevels)
+    {
+        if (Level)
+        {
+            Level->InjectWindAtPosition(WorldPos, VelocityToInject, Radius);
+        }
+    }
 
-    //float Time = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    // Async solver owns the grid, or a background Initialize is still building it. Queue for the next step to apply,
+    // in world space since the origin may scroll before then.
+    if (bAsyncSimulation || (bInitialized && !IsReady()))
+    {
+        FScopeLock Lock(&PendingInjectionLock);
+        PendingInjections.Add({ WorldPos, VelocityToInject, Radius });
+        return;
+    }
 
-    for (int Z = 0; Z < SizeZ; ++Z)
+    // Sparse bricks are world-anchored, the dense grid is relative to its origin
+    const FVector LocalWorldPos = IsSparse() ? WorldPos : WorldPos - FieldOrigin;
+
+    WaitForAsyncUpdate();
+
+    if (IsSparse())
     {
-        for (int Y = 0; Y < SizeY; ++Y)
-        {
-            for (int X = 0; X < SizeX; ++X)
-            {
-                int Index = GetIndex(X, Y, Z);
-                FVector PosWorld = FVector(X, Y, Z) * CellSize;
+        InjectSparse(LocalWorldPos, VelocityToInject, Radius);
+        return;
+    }
 
-                // Sample noise for turbulence
-                float TurbX = Noise.GetNoise((float)X * NoiseScale, (float)Y * NoiseScale, (float)Z * NoiseScale);
-                float TurbY = Noise.GetNoise((float)X * NoiseScale + 1000, (float)Y * NoiseScale + 1000, (float)Z * NoiseScale + 1000);
-                float TurbZ = Noise.GetNoise((float)X * NoiseScale + 2000, (float)Y * NoiseScale + 2000, (float)Z * NoiseScale + 2000);
+    // No step is running, the tracked slices are this injection's alone. The front now differs from the previous
+    // step whether or not tiles are tracked, so new blends of the two are new wind again.
+    ResetDirtySlices();
+    QuiescentStepCount = 0;
+    if (IsPacked())
+    {
+        ApplyInjection(PackedVelocity, LocalWorldPos, VelocityToInject, Radius);
+    }
+    else
+    {
+        ApplyInjection(Velocity, LocalWorldPos, VelocityToInject, Radius);
+    }
+    BumpGridVersion(&DirtySlices);
 
-                // Make turbulence gentle
-                FVector Turbulence = FVector(TurbX, TurbY, TurbZ) * TurbulenceStrength;
+    // Fixed-rate views blend the front with the previous step, the injected slices keep changing with the alpha
+    if (LastStepDirtySlices.Num() == DirtySlices.Num())
+    {
+        LastStepDirtySlices.CombineWithBitwiseOR(DirtySlices, EBitwiseOperatorFlags::MinSize);
+    }
+    else
+    {
+        LastStepDirtySlices = DirtySlices;
+    }
+}
 
-                // Combine steady bias and turbulence
-                FVector WindVelocity = (WindBias + Turbulence) * WindScale;
+void UWindVectorField::InjectSparse(const FVector& WorldPos, const FVector& VelocityToInject, float Radius)
+{
+    // Can activate bricks and grow the brick storage under a reader
+    FWriteScopeLock WriteLock(PublishLock);
+    Bricks.Inject(FVector3f(WorldPos / CellSize), FVector3f(VelocityToInject), Radius / CellSize, MaxActiveBricks);
+    BumpGridVersion();
+}
 
-                // Apply to velocity grid
-                VelocityGrid[Index] += WindVelocity * DeltaTime;
-            }
-        }
+TArray<UWindVectorField::FPendingInjection> UWindVectorField::TakePendingInjections()
+{
+    TArray<FPendingInjection> Injections;
+    {
+        FScopeLock Lock(&PendingInjectionLock);
+        Swap(Injections, PendingInjections);
     }
+    return Injections;
 }
 
-void UWindVectorField::InjectWindAtPosition(const FVector& WorldPos, const FVector& VelocityToInject, float Radius)
+template<typename ChannelsType>
+void UWindVectorField::ApplyPendingInjections(ChannelsType& Target)
+{
+    for (const FPendingInjection& Injection : TakePendingInjections())
+    {
+        ApplyInjection(Target, Injection.WorldPos - StepFieldOrigin, Injection.Velocity, Injection.Radius);
+    }
+}
+
+template<typename ChannelsType>
+void UWindVectorField::ApplyInjection(ChannelsType& Target, const FVector& LocalWorldPos, const FVector& VelocityToInject, float Radius)
 {
-    FVector LocalWorldPos = WorldPos - FieldOrigin;
     FVector GridPosF = LocalWorldPos / CellSize;
 
     // Calculate the affected grid cells within radius
@@ -231,23 +2354,191 @@ void UWindVectorField::InjectWindAtPosition(const FVector& WorldPos, const FVect
                     int idx = GetIndex(x, y, z);
                     // Add velocity scaled by how close cell is to center
                     float strength = 1.0f - (dist / Radius);
-                    VelocityGrid[idx] += VelocityToInject * strength;
+                    Target.Add(idx, FVector3f(VelocityToInject * strength) * GetOpenFactor(idx));
                 }
             }
         }
     }
+
+    WakeTiles(FIntVector(minX, minY, minZ), FIntVector(maxX, maxY, maxZ));
+    MarkSlicesDirty(minZ, maxZ);
 }
 
 FVector UWindVectorField::SampleWindAtPosition(const FVector& WorldPos) const
 {
-    if (VelocityGrid.Num() == 0 || SizeX <= 1 || SizeY <= 1 || SizeZ <= 1)
+    if (IsSparse())
+    {
+        FReadScopeLock ReadLock(PublishLock);
+        return FVector(GetAmbientWind() + Bricks.Sample(FVector3f(WorldPos / CellSize)));
+    }
+
+    // Calm air until a background Initialize has built the grid
+    const bool bSequenceFrames = SequencePlayer.HasFrames();
+    if (bInitialized && !IsReady() && !bSequenceFrames)
+    {
+        return FVector(GetAmbientWind());
+    }
+
+    // The view pins the last completed step, so this is safe while an async step is running
+    const FWindGridView View = GetGridView();
+    if (!View.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("SampleWindAtPosition called on uninitialized field. Asset name: %s"), *GetNameSafe(this));
         return FVector::ZeroVector;
     }
 
-    FVector GridPos = WorldPos / CellSize;
-    return SampleVelocityAtGridPosition(GridPos);
+    // Outside this grid, the finest clipmap level that still contains the point answers
+    if (ClipmapLevels.Num() > 0 && !bSequenceFrames && !View.ContainsWorldPosition(FVector3f(WorldPos)))
+    {
+        TArray<FWindGridView, TInlineAllocator<8>> Views;
+        GetClipmapViews(View, Views);
+        const FWindGridView& LevelView = PickClipmapView(Views, FVector3f(WorldPos));
+        return FVector(LevelView.SampleGrid(FVector3f(WorldPos / LevelView.CellSize - FVector(LevelView.GridOffset))));
+    }
+
+    FVector3f GridPos = FVector3f(WorldPos / CellSize - FVector(View.GridOffset));
+    return FVector(View.SampleGrid(GridPos));
+}
+
+void UWindVectorField::SampleWindBatch(TConstArrayView<FVector3f> Positions, TArrayView<FVector3f> OutVelocities) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_WindField_SampleBatch);
+    INC_DWORD_STAT_BY(STAT_WindField_BatchSamples, Positions.Num());
+
+    if (IsSparse())
+    {
+        check(OutVelocities.Num() >= Positions.Num());
+
+        // One lock for the whole batch, most points fall outside any brick and only pay the lookup
+        FReadScopeLock ReadLock(PublishLock);
+        const FVector3f Ambient = GetAmbientWind();
+        for (int32 i = 0; i < Positions.Num(); ++i)
+        {
+            OutVelocities[i] = Ambient + Bricks.Sample(Positions[i] / CellSize);
+        }
+        return;
+    }
+
+    const bool bSequenceFrames = SequencePlayer.HasFrames();
+    if (bInitialized && !IsReady() && !bSequenceFrames)
+    {
+        check(OutVelocities.Num() >= Positions.Num());
+        const FVector3f Ambient = GetAmbientWind();
+        for (int32 i = 0; i < Positions.Num(); ++i)
+        {
+            OutVelocities[i] = Ambient;
+        }
+        return;
+    }
+
+    const FWindGridView View = GetGridView();
+    if (!View.IsValid() && Positions.Num() > 0 && !bWarnedInvalidBatch.exchange(true, std::memory_order_relaxed))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SampleWindBatch called on uninitialized field. Asset name: %s"), *GetNameSafe(this));
+    }
+
+    // Clipmaps pick a level per point, the level views are grabbed once for the whole batch
+    if (ClipmapLevels.Num() > 0 && !bSequenceFrames && View.IsValid())
+    {
+        check(OutVelocities.Num() >= Positions.Num());
+
+        TArray<FWindGridView, TInlineAllocator<8>> Views;
+        GetClipmapViews(View, Views);
+        for (int32 i = 0; i < Positions.Num(); ++i)
+        {
+            const FWindGridView& LevelView = PickClipmapView(Views, Positions[i]);
+            OutVelocities[i] = LevelView.SampleGrid(Positions[i] / LevelView.CellSize - LevelView.GridOffset);
+        }
+        return;
+    }
+
+    View.SampleBatch(Positions, OutVelocities);
+}
+
+FWindGridView UWindVectorField::GetGridView() const
+{
+    // Once its first frames are decoded a playing sequence is what everyone sees, the solver keeps MakeGridView
+    if (SequencePlayer.HasFrames())
+    {
+        FReadScopeLock ReadLock(PublishLock);
+        FWindGridView View;
+        if (SequencePlayer.MakeView(View))
+        {
+            return View;
+        }
+    }
+
+    // The background Initialize allocates the buffers the view would point into
+    if (!IsReady())
+    {
+        return FWindGridView();
+    }
+
+    FReadScopeLock ReadLock(PublishLock);
+    return bHoldGridView ? HeldGridView : MakeGridViewLocked(bFixedTimestep);
+}
+
+FWindGridView UWindVectorField::MakeGridView(bool bInterpolate) const
+{
+    FReadScopeLock ReadLock(PublishLock);
+    return MakeGridViewLocked(bInterpolate);
+}
+
+FWindGridView UWindVectorField::MakeGridViewLocked(bool bInterpolate) const
+{
+    // Sparse fields have no dense grid to view, the view stays invalid
+    FWindGridView View;
+    const bool bPacked = IsPacked();
+    const int32 NumAllocatedCells = GetAllocatedCells();
+    if (!IsSparse() && NumAllocatedCells == GetStorageCellCount() && NumAllocatedCells > 0)
+    {
+        if (bPacked)
+        {
+            View.X = PackedVelocity.X.GetData();
+            View.Y = PackedVelocity.Y.GetData();
+            View.Z = PackedVelocity.Z.GetData();
+            View.Precision = PackedVelocity.Precision;
+            View.DecodeScale = PackedVelocity.DecodeScale;
+        }
+        else
+        {
+            View.X = Velocity.X.GetData();
+            View.Y = Velocity.Y.GetData();
+            View.Z = Velocity.Z.GetData();
+        }
+    }
+    View.SizeX = SizeX;
+    View.SizeY = SizeY;
+    View.SizeZ = SizeZ;
+    View.CellSize = CellSize;
+    View.RingOffset = RingOffset;
+    View.Layout = GridLayout;
+
+    // Sampled relative to the origin, the frame injections, the obstacle mask and the GPU shader already use.
+    // A scrolling grid's origin is the corner of its window.
+    View.GridOffset = bScrollWindowValid ? FVector3f(WindowOriginCell) : FVector3f(FieldOrigin / CellSize);
+
+    // Blend from the previous step, which shares the ring layout of the front buffer
+    const FWindVectorChannels& Previous = GetPreviousVelocity();
+    const FWindPackedChannels& PackedPrevious = GetPreviousPackedVelocity();
+    const int32 NumPreviousCells = bPacked ? PackedPrevious.Num() : Previous.Num();
+    if (bInterpolate && View.X && NumPreviousCells == NumAllocatedCells && SimulationAlpha < 1.0f)
+    {
+        if (bPacked)
+        {
+            View.PrevX = PackedPrevious.X.GetData();
+            View.PrevY = PackedPrevious.Y.GetData();
+            View.PrevZ = PackedPrevious.Z.GetData();
+        }
+        else
+        {
+            View.PrevX = Previous.X.GetData();
+            View.PrevY = Previous.Y.GetData();
+            View.PrevZ = Previous.Z.GetData();
+        }
+        View.Alpha = SimulationAlpha;
+    }
+    return View;
 }
 
 FVector UWindVectorField::GetPhoenixPosition() const
@@ -279,6 +2570,9 @@ void UWindVectorField::DebugDraw(float Scale) const
     int Step = 3;
     FVector GridOrigin = PhoenixPos - FVector(SizeX, SizeY, SizeZ) * 0.5f * CellSize;
 
+    const FWindGridView View = GetGridView();
+    if (!View.IsValid()) return;
+
     for (int z = 0; z < SizeZ; z += Step)
     {
         for (int y = 0; y < SizeY; y += Step)
@@ -288,10 +2582,10 @@ void UWindVectorField::DebugDraw(float Scale) const
                 int Index = GetIndex(x, y, z);
                 FVector Start = GridOrigin + FVector(x, y, z) * CellSize;
 
-                FVector Velocity = VelocityGrid[Index];
-                if (Velocity.IsNearlyZero()) continue;
+                FVector CellVelocity(View.GetCell(Index));
+                if (CellVelocity.IsNearlyZero()) continue;
 
-                FVector End = Start + (Velocity * Scale * 0.1f);
+                FVector End = Start + (CellVelocity * Scale * 0.1f);
 
                 DrawDebugDirectionalArrow(World, Start, End, 50.0, FColor::Blue, false, -0.5f, 0, 1.0f);
             }
@@ -301,8 +2595,60 @@ void UWindVectorField::DebugDraw(float Scale) const
 
 void UWindVectorField::ResetField()
 {
-    VelocityGrid.Empty();
-    VelocityGrid.SetNumZeroed(SizeX * SizeY * SizeZ);
+    WaitForAsyncUpdate();
+
+    Velocity.Empty();
+    BackVelocity.Empty();
+    RetiredVelocity.Empty();
+    PackedVelocity.Empty();
+    PackedBackVelocity.Empty();
+    PackedRetiredVelocity.Empty();
+    SubstepVelocity.Empty();
+    PackedSubstepVelocity.Empty();
+    bHoldGridView = false;
+    AdvectScratch.Empty();
+    if (!IsSparse())
+    {
+        AllocateFrontBuffer();
+    }
+    {
+        FWriteScopeLock WriteLock(PublishLock);
+        Bricks.Reset();
+    }
+
+    // Levels are rebuilt from the current settings by the next Initialize or Update
+    for (UWindVectorField* Level : ClipmapLevels)
+    {
+        if (Level)
+        {
+            Level->WaitForAsyncUpdate();
+        }
+    }
+    ClipmapLevels.Reset();
+    ClipmapPendingDeltaTime.Reset();
+    WindowOriginCell = FIntVector::ZeroValue;
+    RingOffset = FIntVector::ZeroValue;
+    bScrollWindowValid = false;
+    PendingAsyncDeltaTime = 0.0f;
+    SimulationAccumulator = 0.0f;
+    SimulationAlpha = 1.0f;
+    PendingSimulationAlpha = -1.0f;
+    ActivityTiles.Empty();
+    ActivityTileCounts = FIntVector::ZeroValue;
+    NumActiveTiles = 0;
+    QuiescentStepCount = 0;
+    PressureSolver.Reset();
+    VorticityConfinement.Reset();
+    {
+        FScopeLock Lock(&PendingInjectionLock);
+        PendingInjections.Reset();
+    }
+
+    // A field that is initialized again has to warm up again before it is sampled
+    if (!bInitialized)
+    {
+        bReady = false;
+    }
     Initialize();
 }
 
@@ -311,6 +2657,22 @@ void UWindVectorField::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 {
     Super::PostEditChangeProperty(PropertyChangedEvent);
 
+    WaitForAsyncUpdate();
+
+    // Force parameters only invalidate the cached force field, the simulated wind can keep running
+    const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+    if (IsForceFieldProperty(PropertyName) && (GetAllocatedCells() > 0 || IsSparse()))
+    {
+        // Sparse fields read the ambient wind straight from the properties
+        if (!IsSparse())
+        {
+            RebuildForceField();
+        }
+        PropagateForceParameters();
+        MarkPackageDirty();
+        return;
+    }
+
     bInitialized = false;
 
     ResetField();
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WindVorticityConfinement.h"
+#include "Async/ParallelFor.h"
+
+void FWindVorticityConfinement::Resize(const FIntVector& InSize)
+{
+    if (Size == InSize)
+    {
+        return;
+    }
+
+    Size = InSize;
+    const int32 NumCells = Size.X * Size.Y * Size.Z;
+    Channels.SetNumZeroed(NumCells);
+    Curl.SetNumZeroed(NumCells);
+    CurlMagnitude.SetNumZeroed(NumCells);
+}
+
+void FWindVorticityConfinement::Reset()
+{
+    Size = FIntVector::ZeroValue;
+    Channels.Empty();
+    Curl.Empty();
+    CurlMagnitude.Empty();
+}
+
+SIZE_T FWindVorticityConfinement::GetAllocatedSize() const
+{
+    return Channels.X.GetAllocatedSize() * 3 + Curl.X.GetAllocatedSize() * 3 + CurlMagnitude.GetAllocatedSize();
+}
+
+// X derivative of one row into Out (Out += Sign * d/dx), central inside and one-sided at the two ends
+static FORCEINLINE void AddRowDerivativeX(const float* RESTRICT Row, float* RESTRICT Out, int32 Count, float Sign, float InvCellSize)
+{
+    const float HalfScale = 0.5f * InvCellSize * Sign;
+    for (int32 x = 1; x < Count - 1; ++x)
+    {
+        Out[x] += (Row[x + 1] - Row[x - 1]) * HalfScale;
+    }
+    Out[0] += (Row[1] - Row[0]) * InvCellSize * Sign;
+    Out[Count - 1] += (Row[Count - 1] - Row[Count - 2]) * InvCellSize * Sign;
+}
+
+bool FWindVorticityConfinement::Compute(float Strength, float CellSize, float DeltaTime, bool bParallel)
+{
+    // A flat grid has no curl on its thin axis, the channels still hold the velocity then
+    if (Size.X < 2 || Size.Y < 2 || Size.Z < 2 || CellSize <= 0.0f)
+    {
+        return false;
+    }
+
+    const int32 RowStride = Size.X;
+    const int32 SliceStride = Size.X * Size.Y;
+    const float InvCellSize = 1.0f / CellSize;
+    const EParallelForFlags Flags = bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+    // Neighbour rows are clamped at the grid faces, the derivative scale follows whether that made it one-sided
+    auto GetNeighbourRows = [this, RowStride, SliceStride, InvCellSize](int32 y, int32 z, int32& OutYm, int32& OutYp, int32& OutZm, int32& OutZp, float& OutInvDY, float& OutInvDZ)
+    {
+        const int32 y0 = FMath::Max(y - 1, 0);
+        const int32 y1 = FMath::Min(y + 1, Size.Y - 1);
+        const int32 z0 = FMath::Max(z - 1, 0);
+        const int32 z1 = FMath::Min(z + 1, Size.Z - 1);
+        OutYm = y0 * RowStride + z * SliceStride;
+        OutYp = y1 * RowStride + z * SliceStride;
+        OutZm = y * RowStride + z0 * SliceStride;
+        OutZp = y * RowStride + z1 * SliceStride;
+        OutInvDY = InvCellSize / (y1 - y0);
+        OutInvDZ = InvCellSize / (z1 - z0);
+    };
+
+    // Curl and its magnitude
+    ParallelFor(Size.Z, [&](int32 z)
+    {
+        const float* RESTRICT U = Channels.X.GetData();
+        const float* RESTRICT V = Channels.Y.GetData();
+        const float* RESTRICT W = Channels.Z.GetData();
+
+        for (int32 y = 0; y < Size.Y; ++y)
+        {
+            int32 Ym, Yp, Zm, Zp;
+            float InvDY, InvDZ;
+            GetNeighbourRows(y, z, Ym, Yp, Zm, Zp, InvDY, InvDZ);
+
+            const int32 Row = y * RowStride + z * SliceStride;
+            float* RESTRICT CX = Curl.X.GetData() + Row;
+            float* RESTRICT CY = Curl.Y.GetData() + Row;
+            float* RESTRICT CZ = Curl.Z.GetData() + Row;
+
+            // (dW/dy - dV/dz, dU/dz - dW/dx, dV/dx - dU/dy), the Y and Z terms first since they need no edge cases
+            for (int32 x = 0; x < Size.X; ++x)
+            {
+                CX[x] = (W[Yp + x] - W[Ym + x]) * InvDY - (V[Zp + x] - V[Zm + x]) * InvDZ;
+                CY[x] = (U[Zp + x] - U[Zm + x]) * InvDZ;
+                CZ[x] = -(U[Yp + x] - U[Ym + x]) * InvDY;
+            }
+            AddRowDerivativeX(W + Row, CY, Size.X, -1.0f, InvCellSize);
+            AddRowDerivativeX(V + Row, CZ, Size.X, 1.0f, InvCellSize);
+
+            float* RESTRICT Magnitude = CurlMagnitude.GetData() + Row;
+            for (int32 x = 0; x < Size.X; ++x)
+            {
+                Magnitude[x] = FMath::Sqrt(CX[x] * CX[x] + CY[x] * CY[x] + CZ[x] * CZ[x]);
+            }
+        }
+    }, Flags);
+
+    // Confinement, pushes along N x Curl where N points towards stronger rotation. The velocity is no longer needed,
+    // so the channels are reused for the result.
+    const float Scale = Strength * CellSize * DeltaTime;
+    ParallelFor(Size.Z, [&](int32 z)
+    {
+        const float* RESTRICT M = CurlMagnitude.GetData();
+
+        for (int32 y = 0; y < Size.Y; ++y)
+        {
+            int32 Ym, Yp, Zm, Zp;
+            float InvDY, InvDZ;
+            GetNeighbourRows(y, z, Ym, Yp, Zm, Zp, InvDY, InvDZ);
+
+            const int32 Row = y * RowStride + z * SliceStride;
+            float* RESTRICT OutX = Channels.X.GetData() + Row;
+            float* RESTRICT OutY = Channels.Y.GetData() + Row;
+            float* RESTRICT OutZ = Channels.Z.GetData() + Row;
+            const float* RESTRICT CX = Curl.X.GetData() + Row;
+            const float* RESTRICT CY = Curl.Y.GetData() + Row;
+            const float* RESTRICT CZ = Curl.Z.GetData() + Row;
+
+            // Gradient of |Curl| goes into the output channels first
+            for (int32 x = 0; x < Size.X; ++x)
+            {
+                OutX[x] = 0.0f;
+                OutY[x] = (M[Yp + x] - M[Ym + x]) * InvDY;
+                OutZ[x] = (M[Zp + x] - M[Zm + x]) * InvDZ;
+            }
+            AddRowDerivativeX(M + Row, OutX, Size.X, 1.0f, InvCellSize);
+
+            for (int32 x = 0; x < Size.X; ++x)
+            {
+                // Flat regions have no gradient to follow, the small epsilon keeps them at zero instead of NaN
+                const float InvLength = 1.0f / (FMath::Sqrt(OutX[x] * OutX[x] + OutY[x] * OutY[x] + OutZ[x] * OutZ[x]) + UE_SMALL_NUMBER);
+                const float NX = OutX[x] * InvLength;
+                const float NY = OutY[x] * InvLength;
+                const float NZ = OutZ[x] * InvLength;
+
+                OutX[x] = (NY * CZ[x] - NZ * CY[x]) * Scale;
+                OutY[x] = (NZ * CX[x] - NX * CZ[x]) * Scale;
+                OutZ[x] = (NX * CY[x] - NY * CX[x]) * Scale;
+            }
+        }
+    }, Flags);
+    return true;
+}
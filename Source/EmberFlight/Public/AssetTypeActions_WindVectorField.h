@@ -6,6 +6,8 @@
 #if WITH_EDITOR
 #include "AssetTypeActions_Base.h"
 
+class UWindVectorField;
+
 class EMBERFLIGHT_API FAssetTypeActions_WindVectorField : public FAssetTypeActions_Base
 {
 public:
@@ -16,5 +18,13 @@ public:
     virtual UClass* GetSupportedClass() const override;
 
     virtual uint32 GetCategories() override { return EAssetTypeCategories::Misc; }
+
+    virtual bool HasActions(const TArray<UObject*>& InObjects) const override { return true; }
+
+    virtual void GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section) override;
+
+private:
+    void ExecuteBakeSteadyState(TArray<TWeakObjectPtr<UWindVectorField>> Fields);
+    void ExecuteClearSteadyState(TArray<TWeakObjectPtr<UWindVectorField>> Fields);
 };
-#endif
\ No newline at end of file
+#endif
@@ -19,6 +19,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind")
     TObjectPtr<UWindVectorField> WindField;
 
+    /** Uploads only the Z slices of the grid that changed, unless they are more than this fraction of it. 0 always uploads the whole grid. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float PartialUploadMaxFraction = 0.5f;
+
     // CPU Sim Functionality
     virtual void GetFunctions(TArray<FNiagaraFunctionSignature>& OutFunctions) override;
     virtual void GetVMExternalFunction(const FVMExternalFunctionBindingInfo& BindingInfo, void* InstanceData, FVMExternalFunction& OutFunc) override;
@@ -40,9 +44,7 @@ public:
     virtual void SetShaderParameters(const FNiagaraDataInterfaceSetShaderParametersContext& Context) const override;
     virtual void ProvidePerInstanceDataForRenderThread(void* DataForRenderThread, void* PerInstanceData, const FNiagaraSystemInstanceID& SystemInstance) override;
     virtual bool PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds) override;
-    virtual bool PerInstanceTickPostSimulate(void* PerInstanceData, FNiagaraSystemInstance* InSystemInstance, float DeltaSeconds);
     virtual bool HasPreSimulateTick() const override { return true; }
-    virtual bool HasPostSimulateTick() const override { return true; }
     virtual bool HasTickGroupPrereqs() const override { return true; }
     
 #if WITH_EDITOR
@@ -52,12 +54,29 @@ public:
 
 struct FNDIWindFieldBuffer : public FRenderResource
 {
-    FBufferRHIRef VelocityGridBufferRHI; // Persistent GPU buffer
+    TRefCountPtr<FRDGPooledBuffer> VelocityGridPooledBuffer; // Persistent GPU buffer, registered with the graph to upload into
+    FBufferRHIRef VelocityGridBufferRHI; // RHI buffer of the pooled one
     FShaderResourceViewRHIRef VelocityGridSRV; // SRV for Niagara shader binding
 
     int32 NumElements = 0;
     bool bIsInitialized = false;
 
+    // Grid queued by the game thread, uploaded by the first PreStage of any instance sharing the buffer. Render thread only.
+    // With ranges only those are uploaded, without the whole grid.
+    const FVector4f* PendingUpload = nullptr;
+    int32 PendingUploadCount = 0;
+    TArray<FIntPoint> PendingUploadRanges;
+
+    /**
+    * Parks a grid for the next PreStage. Ranges are merged with those of an upload still pending, the newest grid holds
+    * every cell the older one would have sent. No ranges, here or already pending, uploads the whole grid, and so do
+    * merged ranges covering more than MaxFraction of it.
+    */
+    void QueueUpload(const FVector4f* Grid, int32 Count, TConstArrayView<FIntPoint> Ranges, float MaxFraction);
+
+    /** Bytes the pending upload sends, what PreStage adds to the NDI Upload Bytes stat */
+    int64 GetPendingUploadBytes() const;
+
     virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
     virtual void ReleaseRHI() override;
 };
@@ -83,7 +102,7 @@ struct FNDIWindFieldInstanceData
     UPROPERTY()
     UWindVectorField* WindField = nullptr;
     
-    // Pointer to the shared per-instance data that owns the buffer and CPU grids
+    // Pointer to the data shared by every instance of the same field, owns the buffer and CPU grids
     FNDIWindFieldData* InstanceDataOwner = nullptr;
 
     int32 WriteIndex = 0;
@@ -108,28 +127,77 @@ struct FNDIWindFieldRenderData
     const FVector4f* VelocityGridPtr = nullptr; // Zero-copy: Only a pointer and count now
     int32 VelocityGridCount = 0;
 
+    // Changed parts of the grid as (first element, number of elements), empty to upload all of it
+    TArray<FIntPoint> UploadRanges;
+    float PartialUploadMaxFraction = 0.0f;
+
     FNDIWindFieldBuffer* AssetBuffer = nullptr; // Raw pointer to GPU buffer, not owning - managed by FNDIWindFieldData
     bool bUploadQueuedThisFrame = false;
 };
 
-// This struct owns the CPU velocity arrays AND the GPU buffer resource
+// Size and window of a copied grid, what the CPU VM needs to sample it without going back to the field
+struct FNDIWindFieldGridInfo
+{
+    FIntVector Size = FIntVector::ZeroValue;
+    float CellSize = 0.0f;
+    FVector3f GridOffset = FVector3f::ZeroVector;
+
+    int32 NumCells() const { return Size.X * Size.Y * Size.Z; }
+
+    void Set(const FWindGridView& View)
+    {
+        Size = View.IsValid() ? FIntVector(View.SizeX, View.SizeY, View.SizeZ) : FIntVector::ZeroValue;
+        CellSize = View.CellSize;
+        GridOffset = View.GridOffset;
+    }
+};
+
+// This struct owns the CPU velocity arrays AND the GPU buffer resource. There is one per field, shared by every
+// system instance sampling it through Acquire/Release, so a field is converted and uploaded once per frame however
+// many emitters read it.
 struct FNDIWindFieldData
 {
-    // WindField pointer, set once per instance init
+    // WindField pointer, set once when the first instance acquires it
     UPROPERTY()
     UWindVectorField* WindField = nullptr;
 
     // Double-buffered velocity grids stored on CPU
     TArray<FVector4f> VelocityGridBuffers[2];
+    FNDIWindFieldGridInfo GridInfos[2];
 
+    // Buffer the first tick of a frame copies into, the CPU VM samples and the render thread uploads it that frame
     int32 WriteIndex = 0;
 
+    // Instances ticking on different threads share the buffers, the first one of a frame does the work
+    FCriticalSection Lock;
+    uint64 LastTickFrame = MAX_uint64;
+    int32 NumUsers = 0;
+
+    // UWindVectorField::GetGridVersion each buffer was copied at, 0 for never
+    uint64 BufferVersions[2] = { 0, 0 };
+
+    // Version last handed to the render thread for upload, the GPU buffer holds it once PreStage ran
+    uint64 LastQueuedVersion = 0;
+
     // Shared GPU buffer resource used for rendering (owned here, shared with render thread)
     TSharedPtr<FNDIWindFieldBuffer, ESPMode::ThreadSafe> AssetBuffer;
 
     // Initialize and manage buffer lifecycle here (e.g. Init, Release functions)
     void InitializeBufferIfNeeded(int32 NumElements);
     void ReleaseBuffer();
+
+    /** Shared data of Field, created with both grids copied for the first user */
+    static FNDIWindFieldData* Acquire(UWindVectorField* Field);
+
+    /** Drops a user, the last one frees the CPU grids and the GPU buffer once the render thread is done with them */
+    static void Release(FNDIWindFieldData* Data);
+
+    /**
+    * Runs of changed Z slices since the version the GPU buffer holds, as element ranges of the float4 copy.
+    * False when the whole grid has to go, because the change is unknown or too large to be worth splitting.
+    */
+    static bool GatherUploadRanges(const UWindVectorField& Field, uint64 GpuVersion, const FNDIWindFieldGridInfo& Info,
+        int32 NumElements, float MaxFraction, TArray<FIntPoint>& OutRanges);
 };
 
 struct FNDIWindFieldProxy : public FNiagaraDataInterfaceProxy
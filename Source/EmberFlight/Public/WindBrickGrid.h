@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+#include "WindGridView.h"
+
+/**
+* Sparse, world-anchored wind disturbance storage made of 8^3 cell bricks.
+* Only bricks that were disturbed (injected into, or reached by advection) are allocated, everything else reads as calm.
+* Cell coordinates are world cells (WorldPos / CellSize), the grid is unbounded apart from the brick budget.
+*/
+struct EMBERFLIGHT_API FWindBrickGrid
+{
+    static constexpr int32 BrickDim = 8;
+    static constexpr int32 BrickCells = BrickDim * BrickDim * BrickDim;
+
+    void Reset();
+
+    int32 GetNumActiveBricks() const { return ActiveBricks.Num(); }
+    SIZE_T GetAllocatedSize() const;
+
+    /** Trilinear sample of the disturbance at a fractional world cell position */
+    FVector3f Sample(const FVector3f& CellPos) const;
+
+    /** Adds velocity with a linear falloff around a world cell position, activating the touched bricks */
+    void Inject(const FVector3f& CellPos, const FVector3f& Velocity, float RadiusCells, int32 MaxBricks);
+
+    /**
+    * Advects and decays every active brick into the back buffer. Ambient is the calm-air wind the disturbance is carried by.
+    * Only writes brick data, so concurrent Sample calls on the front buffer stay valid.
+    */
+    void Advect(float DeltaTime, float CellSize, float Decay, const FVector3f& Ambient, bool bParallel);
+
+    /** Publishes the advected bricks, retires the ones that went quiet and grows into neighbours that are being blown into */
+    void SwapAndUpdateActivity(float RetireSpeed, int32 RetireAfterSteps, int32 MaxBricks);
+
+private:
+    struct FBrickInfo
+    {
+        FIntVector Coord = FIntVector::ZeroValue;
+        int32 QuietSteps = 0;
+        float MaxSpeedSq = 0.0f;
+
+        // Max squared speed on each face (-X, +X, -Y, +Y, -Z, +Z), used to decide which neighbours to activate
+        float FaceMaxSpeedSq[6] = {};
+    };
+
+    static FORCEINLINE FIntVector GetBrickCoord(const FIntVector& Cell)
+    {
+        return FIntVector(Cell.X >> 3, Cell.Y >> 3, Cell.Z >> 3);
+    }
+
+    static FORCEINLINE int32 GetLocalIndex(int32 X, int32 Y, int32 Z)
+    {
+        return (X & (BrickDim - 1)) + (Y & (BrickDim - 1)) * BrickDim + (Z & (BrickDim - 1)) * BrickDim * BrickDim;
+    }
+
+    int32 FindSlot(const FIntVector& BrickCoord) const
+    {
+        const int32* Slot = BrickLookup.Find(BrickCoord);
+        return Slot ? *Slot : INDEX_NONE;
+    }
+
+    FVector3f GetCell(const FIntVector& Cell) const;
+    int32 ActivateBrick(const FIntVector& BrickCoord, int32 MaxBricks);
+    void RetireBrick(int32 Slot);
+
+    // Brick coordinate -> storage slot
+    TMap<FIntVector, int32> BrickLookup;
+
+    // Per slot bookkeeping, slot N owns cells [N * BrickCells, (N + 1) * BrickCells) of both buffers
+    TArray<FBrickInfo> Slots;
+    TArray<int32> ActiveBricks;
+    TArray<int32> FreeSlots;
+
+    FWindVectorChannels Front;
+    FWindVectorChannels Back;
+};
@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+#include "WindGridView.generated.h"
+
+UENUM(BlueprintType)
+enum class EWindVelocityPrecision : uint8
+{
+    /** 32-bit float per component, 12 bytes per cell */
+    Float32,
+    /** IEEE half per component, 6 bytes per cell. Precision falls off with speed. */
+    Half,
+    /** Signed 16-bit per component scaled by a max speed, 6 bytes per cell with uniform precision */
+    Int16
+};
+
+UENUM(BlueprintType)
+enum class EWindGridLayout : uint8
+{
+    /** X-major rows, Z slices. Trilinear corners can be a whole slice apart. */
+    Linear,
+    /** 4x4x4 cell micro-tiles, the eight corners of a cell usually share one or two cache lines per channel */
+    Tiled
+};
+
+/** Float32 structure-of-arrays storage, one 64-byte aligned channel per vector component */
+struct EMBERFLIGHT_API FWindVectorChannels
+{
+    using FChannel = TArray<float, TAlignedHeapAllocator<64>>;
+
+    FChannel X;
+    FChannel Y;
+    FChannel Z;
+
+    int32 Num() const { return X.Num(); }
+
+    void SetNumZeroed(int32 NumCells)
+    {
+        X.SetNumZeroed(NumCells);
+        Y.SetNumZeroed(NumCells);
+        Z.SetNumZeroed(NumCells);
+    }
+
+    void SetNumUninitialized(int32 NumCells)
+    {
+        X.SetNumUninitialized(NumCells);
+        Y.SetNumUninitialized(NumCells);
+        Z.SetNumUninitialized(NumCells);
+    }
+
+    void Empty()
+    {
+        X.Empty();
+        Y.Empty();
+        Z.Empty();
+    }
+
+    FORCEINLINE FVector3f Get(int32 Index) const
+    {
+        return FVector3f(X[Index], Y[Index], Z[Index]);
+    }
+
+    FORCEINLINE void Set(int32 Index, const FVector3f& Value)
+    {
+        X[Index] = Value.X;
+        Y[Index] = Value.Y;
+        Z[Index] = Value.Z;
+    }
+
+    FORCEINLINE void Add(int32 Index, const FVector3f& Value)
+    {
+        X[Index] += Value.X;
+        Y[Index] += Value.Y;
+        Z[Index] += Value.Z;
+    }
+};
+
+/** 16-bit structure-of-arrays storage, half floats or max-speed scaled int16 depending on Precision */
+struct EMBERFLIGHT_API FWindPackedChannels
+{
+    using FChannel = TArray<uint16, TAlignedHeapAllocator<64>>;
+
+    FChannel X;
+    FChannel Y;
+    FChannel Z;
+
+    EWindVelocityPrecision Precision = EWindVelocityPrecision::Half;
+
+    // Int16 only, the speed of one quantization step
+    float DecodeScale = 1.0f;
+
+    int32 Num() const { return X.Num(); }
+
+    void Configure(EWindVelocityPrecision InPrecision, float MaxSpeed)
+    {
+        Precision = InPrecision;
+        DecodeScale = FMath::Max(MaxSpeed, UE_KINDA_SMALL_NUMBER) / MAX_int16;
+    }
+
+    // All-zero bits decode to zero in both formats
+    void SetNumZeroed(int32 NumCells)
+    {
+        X.SetNumZeroed(NumCells);
+        Y.SetNumZeroed(NumCells);
+        Z.SetNumZeroed(NumCells);
+    }
+
+    void Empty()
+    {
+        X.Empty();
+        Y.Empty();
+        Z.Empty();
+    }
+
+    FORCEINLINE float Decode(uint16 Value) const
+    {
+        return Precision == EWindVelocityPrecision::Half ? FPlatformMath::LoadHalf(&Value) : (int16)Value * DecodeScale;
+    }
+
+    FORCEINLINE uint16 Encode(float Value) const
+    {
+        if (Precision == EWindVelocityPrecision::Half)
+        {
+            uint16 Half;
+            FPlatformMath::StoreHalf(&Half, Value);
+            return Half;
+        }
+
+        // Saturates at the configured max speed instead of wrapping
+        return (uint16)(int16)FMath::Clamp(FMath::RoundToInt(Value / DecodeScale), -MAX_int16, MAX_int16);
+    }
+
+    FORCEINLINE FVector3f Get(int32 Index) const
+    {
+        return FVector3f(Decode(X[Index]), Decode(Y[Index]), Decode(Z[Index]));
+    }
+
+    FORCEINLINE void Set(int32 Index, const FVector3f& Value)
+    {
+        X[Index] = Encode(Value.X);
+        Y[Index] = Encode(Value.Y);
+        Z[Index] = Encode(Value.Z);
+    }
+
+    FORCEINLINE void Add(int32 Index, const FVector3f& Value)
+    {
+        Set(Index, Get(Index) + Value);
+    }
+};
+
+/**
+* Read-only view over a SoA velocity grid, float32 or 16-bit packed.
+* Validity is checked once by the caller (IsValid), the sampling functions themselves never re-validate,
+* which is what makes them cheap enough to call for tens of thousands of points per frame.
+*/
+struct EMBERFLIGHT_API FWindGridView
+{
+    // Channel data, float or uint16 elements depending on Precision
+    const void* X = nullptr;
+    const void* Y = nullptr;
+    const void* Z = nullptr;
+
+    EWindVelocityPrecision Precision = EWindVelocityPrecision::Float32;
+
+    // Int16 only, the speed of one quantization step
+    float DecodeScale = 1.0f;
+
+    EWindGridLayout Layout = EWindGridLayout::Linear;
+
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    int32 SizeZ = 0;
+    float CellSize = 0.0f;
+
+    // Ring buffer rotation of the storage (scrolling grids), zero for a plain linear grid
+    FIntVector RingOffset = FIntVector::ZeroValue;
+
+    // Subtracted from WorldPos / CellSize to get window-local grid coordinates
+    FVector3f GridOffset = FVector3f::ZeroVector;
+
+    // Previous simulation step and the blend from it towards X/Y/Z, null unless the field interpolates fixed-rate steps
+    const void* PrevX = nullptr;
+    const void* PrevY = nullptr;
+    const void* PrevZ = nullptr;
+    float Alpha = 1.0f;
+
+    // Matches the requirements of UWindVectorField::SampleWindAtPosition
+    bool IsValid() const
+    {
+        return X && Y && Z && SizeX > 1 && SizeY > 1 && SizeZ > 1 && CellSize > 0.0f;
+    }
+
+    // Whether a world position falls inside the grid window, i.e. would be sampled without clamping
+    bool ContainsWorldPosition(const FVector3f& WorldPos) const
+    {
+        const FVector3f GridPos = WorldPos / CellSize - GridOffset;
+        return GridPos.X >= 0.0f && GridPos.X <= SizeX - 1
+            && GridPos.Y >= 0.0f && GridPos.Y <= SizeY - 1
+            && GridPos.Z >= 0.0f && GridPos.Z <= SizeZ - 1;
+    }
+
+    // Wraps a value known to be in [0, 2 * Size)
+    static FORCEINLINE int32 WrapOnce(int32 Value, int32 Size)
+    {
+        return Value >= Size ? Value - Size : Value;
+    }
+
+    // Wraps any value, including negative ones, into [0, Size)
+    static FORCEINLINE int32 WrapAny(int32 Value, int32 Size)
+    {
+        const int32 Mod = Value % Size;
+        return Mod < 0 ? Mod + Size : Mod;
+    }
+
+    // One decoded channel element, the precision is a template argument so hot loops can dispatch once
+    template<EWindVelocityPrecision P>
+    static FORCEINLINE float Load(const void* Channel, int32 Index, float Scale)
+    {
+        if constexpr (P == EWindVelocityPrecision::Half)
+        {
+            return FPlatformMath::LoadHalf(static_cast<const uint16*>(Channel) + Index);
+        }
+        else if constexpr (P == EWindVelocityPrecision::Int16)
+        {
+            return static_cast<const int16*>(Channel)[Index] * Scale;
+        }
+        else
+        {
+            return static_cast<const float*>(Channel)[Index];
+        }
+    }
+
+    template<EWindVelocityPrecision P>
+    FORCEINLINE FVector3f GetCellAs(int32 Index) const
+    {
+        const FVector3f Current(Load<P>(X, Index, DecodeScale), Load<P>(Y, Index, DecodeScale), Load<P>(Z, Index, DecodeScale));
+        if (!PrevX)
+        {
+            return Current;
+        }
+        const FVector3f Previous(Load<P>(PrevX, Index, DecodeScale), Load<P>(PrevY, Index, DecodeScale), Load<P>(PrevZ, Index, DecodeScale));
+        return FMath::Lerp(Previous, Current, Alpha);
+    }
+
+    // Cell value at a storage index, blended between the last two steps when interpolating
+    FORCEINLINE FVector3f GetCell(int32 Index) const
+    {
+        switch (Precision)
+        {
+        case EWindVelocityPrecision::Half:  return GetCellAs<EWindVelocityPrecision::Half>(Index);
+        case EWindVelocityPrecision::Int16: return GetCellAs<EWindVelocityPrecision::Int16>(Index);
+        default:                            return GetCellAs<EWindVelocityPrecision::Float32>(Index);
+        }
+    }
+
+    static constexpr int32 TileShift = 2;
+    static constexpr int32 TileDim = 1 << TileShift;
+    static constexpr int32 TileMask = TileDim - 1;
+
+    // Cells a grid of the given size occupies in storage, tiled grids are padded to whole tiles
+    static FORCEINLINE int32 GetStorageCellCount(EWindGridLayout InLayout, int32 InSizeX, int32 InSizeY, int32 InSizeZ)
+    {
+        if (InLayout == EWindGridLayout::Tiled)
+        {
+            return ((InSizeX + TileMask) >> TileShift) * ((InSizeY + TileMask) >> TileShift) * ((InSizeZ + TileMask) >> TileShift)
+                * TileDim * TileDim * TileDim;
+        }
+        return InSizeX * InSizeY * InSizeZ;
+    }
+
+    // Storage index of (already ring-wrapped) storage coordinates
+    static FORCEINLINE int32 ComputeStorageIndex(EWindGridLayout InLayout, int32 SX, int32 SY, int32 SZ, int32 InSizeX, int32 InSizeY)
+    {
+        if (InLayout == EWindGridLayout::Tiled)
+        {
+            const int32 TilesX = (InSizeX + TileMask) >> TileShift;
+            const int32 TilesY = (InSizeY + TileMask) >> TileShift;
+            const int32 Tile = (SX >> TileShift) + ((SY >> TileShift) + (SZ >> TileShift) * TilesY) * TilesX;
+            return Tile * (TileDim * TileDim * TileDim)
+                + (SX & TileMask) + (SY & TileMask) * TileDim + (SZ & TileMask) * TileDim * TileDim;
+        }
+        return SX + SY * InSizeX + SZ * InSizeX * InSizeY;
+    }
+
+    // Storage index of window-local cell coordinates
+    FORCEINLINE int32 GetIndex(int32 InX, int32 InY, int32 InZ) const
+    {
+        return ComputeStorageIndex(Layout,
+            WrapOnce(InX + RingOffset.X, SizeX),
+            WrapOnce(InY + RingOffset.Y, SizeY),
+            WrapOnce(InZ + RingOffset.Z, SizeZ),
+            SizeX, SizeY);
+    }
+
+    /** Trilinear sample at a (fractional) grid position, clamped to the grid bounds */
+    FVector3f SampleGrid(const FVector3f& GridPos) const;
+
+    /** Per-component min and max of the eight cells SampleGrid would blend at GridPos */
+    void GetCornerBounds(const FVector3f& GridPos, FVector3f& OutMin, FVector3f& OutMax) const;
+
+    /** Samples world positions (WorldPos / CellSize - GridOffset), four at a time where vector intrinsics are available */
+    void SampleBatch(TConstArrayView<FVector3f> Positions, TArrayView<FVector3f> OutVelocities) const;
+
+    /** Decodes Count consecutive storage cells into float4 (w = 0), packed formats are widened four cells at a time */
+    void DecodeRun(int32 Index, int32 Count, FVector4f* RESTRICT Dst) const;
+
+private:
+    template<EWindVelocityPrecision P>
+    FVector3f SampleGridAs(const FVector3f& GridPos) const;
+
+    template<EWindVelocityPrecision P>
+    void SampleFour(const FVector3f* Positions, FVector3f* OutVelocities) const;
+};
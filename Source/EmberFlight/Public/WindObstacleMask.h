@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WindObstacleMask.generated.h"
+
+/**
+* Baked 1-bit-per-cell solid mask of static level geometry, world-anchored so scrolling windows and clipmap levels
+* can all resample it. Cells are solid when their box overlaps collision of the baked object type.
+*/
+USTRUCT()
+struct EMBERFLIGHT_API FWindObstacleMask
+{
+    GENERATED_BODY()
+
+    // World-space min corner of cell (0, 0, 0)
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Obstacles")
+    FVector Origin = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Obstacles")
+    FIntVector Size = FIntVector::ZeroValue;
+
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Obstacles")
+    float CellSize = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Obstacles")
+    int32 NumSolidCells = 0;
+
+    // Indexed X + (Y + Z * SizeY) * SizeX, 64 cells per word
+    UPROPERTY()
+    TArray<uint64> Bits;
+
+    bool IsBaked() const { return Bits.Num() > 0; }
+    void Reset();
+
+    /** Whether the mask cell holding WorldPos is solid, anything outside the baked bounds is open air */
+    bool IsSolidAt(const FVector& WorldPos) const;
+
+    /**
+    * Voxelizes the collision of ObjectType inside Bounds. Each 8^3 block is tested with one overlap first,
+    * only blocks that touch geometry are resolved per cell.
+    */
+    void Bake(const UWorld* World, const FBox& Bounds, float InCellSize, ECollisionChannel ObjectType);
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Geometric multigrid Poisson solver for the incompressibility projection of the dense wind grid.
+* Solves Laplacian(P) = Divergence on a cell-centred grid in cell units, with P = 0 outside the grid (open boundary),
+* using red-black Gauss-Seidel V-cycles. Every level is allocated once and reused between steps, and the last
+* pressure is kept as the initial guess for the next solve.
+*/
+struct EMBERFLIGHT_API FWindPressureSolver
+{
+    /** Sizes the level hierarchy, a no-op when the size did not change */
+    void Resize(const FIntVector& InSize);
+    void Reset();
+
+    const FIntVector& GetSize() const { return Levels.Num() > 0 ? Levels[0].Size : FIntVector::ZeroValue; }
+    SIZE_T GetAllocatedSize() const;
+
+    // Finest level, indexed X + (Y + Z * SizeY) * SizeX. Divergence is filled in by the caller before Solve.
+    float* GetDivergence() { return Levels[0].Rhs.GetData(); }
+    const float* GetPressure() const { return Levels[0].Pressure.GetData(); }
+
+    /**
+    * Runs V-cycles until the next one would exceed BudgetSeconds or MaxCycles is reached. At least one cycle always runs.
+    * Returns the number of cycles.
+    */
+    int32 Solve(double BudgetSeconds, int32 MaxCycles, bool bParallel);
+
+private:
+    struct FLevel
+    {
+        FIntVector Size = FIntVector::ZeroValue;
+
+        // Multiplies the 7-point stencil's right hand side. 2^Level rather than the spacing squared (4^Level), which
+        // matches the Galerkin operator of constant prolongation and averaging restriction. With 4^Level the cycle diverges.
+        float StencilScale = 1.0f;
+
+        // Pressure, right hand side (divergence, or the restricted residual on coarse levels) and residual
+        TArray<float> Pressure;
+        TArray<float> Rhs;
+        TArray<float> Residual;
+
+        int32 Num() const { return Size.X * Size.Y * Size.Z; }
+        int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + (Y + Z * Size.Y) * Size.X; }
+    };
+
+    void VCycle(int32 LevelIndex, bool bParallel);
+    void Smooth(FLevel& Level, int32 NumSweeps, bool bParallel);
+    void ComputeResidual(FLevel& Level, bool bParallel);
+    void Restrict(const FLevel& Fine, FLevel& Coarse, bool bParallel);
+    void Prolongate(const FLevel& Coarse, FLevel& Fine, bool bParallel);
+
+    TArray<FLevel> Levels;
+};
@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Serialization/BulkData.h"
+#include "Tasks/Task.h"
+#include "WindGridView.h"
+#include "WindSequence.generated.h"
+
+class UWindVectorField;
+
+/**
+* Pre-simulated wind for playback, one int16-quantized velocity grid per frame in window order
+* (X + (Y + Z * SizeY) * SizeX). Every KeyframeInterval-th frame is stored whole, the frames in between hold the
+* wrapping difference to the frame before. Each frame is a separately zlib-compressed bulk data payload that stays
+* out of the export, so a player only reads the frames around its playhead.
+*/
+UCLASS(BlueprintType)
+class EMBERFLIGHT_API UWindSequence : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /**
+    * Appends the field's current grid as the next frame. The first frame fixes the grid size, cell size and window,
+    * later frames have to match them. Not while a field is playing this sequence.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Wind Sequence")
+    bool RecordFrame(const UWindVectorField* Field);
+
+    UFUNCTION(BlueprintCallable, Category = "Wind Sequence")
+    void ClearFrames();
+
+#if WITH_EDITOR
+    /** Replaces the frames with RecordDuration seconds of SourceField, stepped at FrameRate on a scratch copy */
+    UFUNCTION(CallInEditor, Category = "Wind Sequence|Recording")
+    void RecordFromSourceField();
+#endif
+
+    UFUNCTION(BlueprintPure, Category = "Wind Sequence")
+    int32 GetNumFrames() const { return Frames.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Wind Sequence")
+    float GetDuration() const { return Frames.Num() / FrameRate; }
+
+    int32 GetNumCells() const { return GridSize.X * GridSize.Y * GridSize.Z; }
+    int32 GetKeyframeInterval() const { return FMath::Max(RecordedKeyframeInterval, 1); }
+    bool IsKeyframe(int32 FrameIndex) const { return FrameIndex % GetKeyframeInterval() == 0; }
+
+    /**
+    * Reads and decompresses FrameIndex into Channels, sized and configured here. A keyframe overwrites Channels,
+    * any other frame is added onto it, so Channels has to hold FrameIndex - 1 then. Scratch is reused between calls.
+    * Safe on any thread as long as the frames are not recorded or cleared meanwhile.
+    */
+    bool DecodeFrame(int32 FrameIndex, FWindPackedChannels& Channels, TArray<uint8>& Scratch);
+
+    /** Frames per second of recording and playback */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Sequence", meta = (ClampMin = "1.0"))
+    float FrameRate = 30.0f;
+
+    /** A frame every this many is stored whole, seeking decodes forward from the one before the target */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Sequence", meta = (ClampMin = "1"))
+    int32 KeyframeInterval = 30;
+
+    /** Recorded wind covers -MaxSpeed..MaxSpeed per component, faster wind saturates */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Sequence", meta = (ClampMin = "1.0"))
+    float QuantizationMaxSpeed = 4000.0f;
+
+    /** Field RecordFromSourceField simulates, it is copied so the asset itself is left untouched */
+    UPROPERTY(EditAnywhere, Category = "Wind Sequence|Recording")
+    TObjectPtr<UWindVectorField> SourceField;
+
+    UPROPERTY(EditAnywhere, Category = "Wind Sequence|Recording", meta = (ClampMin = "0.0", Units = "Seconds"))
+    float RecordDuration = 10.0f;
+
+    // Grid the frames were recorded on
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wind Sequence|Grid")
+    FIntVector GridSize = FIntVector::ZeroValue;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wind Sequence|Grid")
+    float CellSize = 0.0f;
+
+    // FWindGridView::GridOffset of the recorded window
+    UPROPERTY(VisibleAnywhere, Category = "Wind Sequence|Grid")
+    FVector3f GridOffset = FVector3f::ZeroVector;
+
+    // KeyframeInterval and QuantizationMaxSpeed as of the first frame, editing those only affects the next recording
+    UPROPERTY(VisibleAnywhere, Category = "Wind Sequence|Grid")
+    int32 RecordedKeyframeInterval = 0;
+
+    UPROPERTY(VisibleAnywhere, Category = "Wind Sequence|Grid")
+    float RecordedMaxSpeed = 0.0f;
+
+    // Compressed size of all frames
+    UPROPERTY(VisibleAnywhere, Category = "Wind Sequence|Grid")
+    int64 CompressedBytes = 0;
+
+protected:
+    virtual void Serialize(FArchive& Ar) override;
+
+private:
+    // One compressed payload per frame, byte planes of the X, Y and Z channels
+    TIndirectArray<FByteBulkData> Frames;
+
+    // Quantized copy of the last recorded frame, the base of the next delta. Rebuilt from the frames after a load.
+    FWindPackedChannels RecordBase;
+
+    bool RestoreRecordBase();
+};
+
+/**
+* Streams a UWindSequence for playback. Frames are read and decoded on a background task ahead of the playhead into
+* a small ring of slots, so resident memory stays at ReadAheadFrames + 5 decoded grids however long the sequence is.
+* Advance runs on the game thread, MakeView on any thread under the owning field's publish lock.
+*/
+class EMBERFLIGHT_API FWindSequencePlayer
+{
+public:
+    ~FWindSequencePlayer() { Stop(); }
+
+    void Start(UWindSequence* InSequence, float StartTime, int32 ReadAheadFrames, bool bInLoop);
+    void Stop();
+
+    bool IsPlaying() const { return Sequence != nullptr; }
+    float GetTime() const { return Time; }
+
+    // Whether a decoded pair of frames is on display, until then the field shows its own grid
+    bool HasFrames() const { return bHasFrames.load(std::memory_order_acquire); }
+
+    /**
+    * Moves the playhead, collects finished decodes and queues the frames now in the read-ahead window.
+    * Returns whether the view changed, i.e. another pair of frames or another blend between them.
+    */
+    bool Advance(float DeltaTime);
+
+    /** Points View at the two frames around the playhead, blended by its position between them */
+    bool MakeView(FWindGridView& View) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FSlot
+    {
+        FWindPackedChannels Channels;
+        int32 Frame = INDEX_NONE;
+    };
+
+    struct FDecodeRequest
+    {
+        int32 Frame;
+        int32 Slot;
+    };
+
+    int32 FindSlot(int32 Frame) const;
+    bool IsSlotInUse(int32 SlotIndex, int32 FirstFrame) const;
+    void QueueDecodes(int32 FirstFrame);
+    void DecodeRequests();
+
+    UWindSequence* Sequence = nullptr;
+    float Time = 0.0f;
+    bool bLoop = false;
+    int32 WindowFrames = 0;
+
+    TArray<FSlot> Slots;
+
+    // Slots on display and the ones displayed before them, which readers may still hold a view of
+    int32 DisplaySlotA = INDEX_NONE;
+    int32 DisplaySlotB = INDEX_NONE;
+    int32 PreviousSlotA = INDEX_NONE;
+    int32 PreviousSlotB = INDEX_NONE;
+    float DisplayAlpha = 0.0f;
+    std::atomic<bool> bHasFrames { false };
+
+    // Decode task state, only touched by the task while it runs
+    UE::Tasks::FTask DecodeTask;
+    TArray<FDecodeRequest> DecodeRequestsInFlight;
+    FWindPackedChannels DecoderState;
+    int32 DecoderFrame = INDEX_NONE;
+    TArray<uint8> DecoderScratch;
+    bool bDecodeFailed = false;
+};
@@ -4,7 +4,45 @@
 #include "UObject/Object.h"
 #include "DrawDebugHelpers.h"
 #include "FastNoiseLite.h"
+#include "WindGridView.h"
+#include "WindBrickGrid.h"
+#include "WindObstacleMask.h"
+#include "WindPressureSolver.h"
+#include "WindVorticityConfinement.h"
+#include "WindSequence.h"
+#include "Tasks/Task.h"
+#include "Serialization/BulkData.h"
 #include "WindVectorField.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("WindField"), STATGROUP_WindField, STATCAT_Advanced);
+
+UENUM(BlueprintType)
+enum class EWindSolverMode : uint8
+{
+    /** Advect, decay and force as three separate passes over the grid */
+    Split,
+    /** One pass per cell doing backtrace, sample, decay and force straight into the back buffer */
+    Fused
+};
+
+UENUM(BlueprintType)
+enum class EWindAdvectionScheme : uint8
+{
+    /** First-order backtrace and trilinear sample, cheap but smears gusts out over a few steps */
+    SemiLagrangian,
+    /** Backtrace, advect the result forward again and correct by half the round-trip error, limited to the sampled cells */
+    MacCormack
+};
+
+UENUM(BlueprintType)
+enum class EWindStorageMode : uint8
+{
+    /** One SizeX * SizeY * SizeZ grid, fully simulated every step */
+    Dense,
+    /** Unbounded world-anchored 8^3 bricks, only disturbed air is stored and simulated */
+    Sparse
+};
+
 UCLASS(Blueprintable, EditInlineNew, DefaultToInstanced)
 class EMBERFLIGHT_API UWindVectorField : public UObject
 {
@@ -15,18 +53,149 @@ public:
 
     UFUNCTION(BlueprintCallable, Category="Wind Field")
     void Initialize();
+
+    /**
+    * Allocates and warms the grid up on a background task. Until IsReady, samplers return the calm-air wind,
+    * Update does nothing and injections are queued for the first step. Initialize waits for it to finish.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void InitializeAsync();
+
+    /** Whether the grid has been built and warmed up */
+    UFUNCTION(BlueprintPure, Category = "Wind Field")
+    bool IsReady() const { return bReady.load(std::memory_order_acquire); }
+
+    // Broadcast on the game thread once the field is ready, from Initialize or the first Update after InitializeAsync
+    FSimpleMulticastDelegate OnReady;
     UFUNCTION(BlueprintCallable, Category="Wind Field")
     void Update(float DeltaTime);
     UFUNCTION(BlueprintCallable, Category = "Wind Field")
     void InjectWindAtPosition(const FVector& WorldPos, const FVector& VelocityToInject, float Radius);
     UFUNCTION(BlueprintCallable, Category="Wind Field")
     FVector SampleWindAtPosition(const FVector& WorldPos) const;
+
+    /**
+    * Samples many world positions in one call. Grid validity is checked once for the whole batch and
+    * points are processed four at a time with vector intrinsics. OutVelocities must be at least as long as Positions.
+    */
+    void SampleWindBatch(TConstArrayView<FVector3f> Positions, TArrayView<FVector3f> OutVelocities) const;
+
     UFUNCTION(BlueprintCallable, Category="Wind Field")
     void DebugDraw(float Scale = 100.0f) const;
 
+    /** Re-evaluates the noise/bias force for every cell. Called automatically when a force parameter changes. */
+    UFUNCTION(BlueprintCallable, Category="Wind Field")
+    void RebuildForceField();
+
+    // Force parameter setters, these flag the cached force field for a rebuild on the next Update
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetWindBias(const FVector& NewWindBias);
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetWindScale(float NewWindScale);
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetTurbulenceStrength(float NewTurbulenceStrength);
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetNoiseScale(float NewNoiseScale);
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetWindNoiseSeed(float NewWindNoiseSeed);
+    UFUNCTION(BlueprintCallable, Category = "Wind Field")
+    void SetWindNoiseFrequency(float NewWindNoiseFrequency);
+
     void ResetField();
 
-    const TArray<FVector>& GetVelocityGrid() const { return VelocityGrid; }
+    /** Moves the field origin, ignored while the grid scrolls with its target */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Grid")
+    void SetFieldOrigin(const FVector& NewFieldOrigin);
+
+    /** Actor the grid window follows when bScrollWithTarget is set. Defaults to the actor tagged "Phoenix". */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Scrolling")
+    void SetScrollTarget(AActor* NewTarget);
+
+    /**
+    * Voxelizes static collision into ObstacleMask, which is saved with the asset. Covers ObstacleBakeBounds, or the
+    * grid's current extent when they are not set, at CellSize.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Obstacles", meta = (WorldContext = "WorldContextObject"))
+    void BakeObstacleMask(const UObject* WorldContextObject);
+
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Obstacles")
+    void ClearObstacleMask();
+
+#if WITH_EDITOR
+    /** Bakes against the level open in the editor */
+    UFUNCTION(CallInEditor, Category = "Wind Field|Obstacles")
+    void BakeObstacleMaskFromEditorWorld();
+#endif
+
+#if WITH_EDITOR
+    /**
+    * Runs SteadyStateBakeSteps solver steps on a scratch copy of this field and stores the settled velocity and force
+    * grids in the asset as compressed bulk data. Loading then copies them in instead of sampling noise and warming up.
+    */
+    void BakeSteadyState();
+    void ClearSteadyState();
+#endif
+
+    /** Whether the asset holds a baked steady state that still matches the grid, force and solver settings */
+    bool HasValidSteadyState() const;
+
+    /**
+    * Plays a recorded sequence instead of simulating. Frames stream in on a background task, samplers and Niagara
+    * see them blended at the playhead like fixed-rate steps. The sequence has to match SizeX/Y/Z and CellSize.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Playback")
+    bool PlaySequence(UWindSequence* Sequence, float StartTime = 0.0f);
+
+    /** Returns to the simulated grid, which resumes from where it was left */
+    UFUNCTION(BlueprintCallable, Category = "Wind Field|Playback")
+    void StopSequence();
+
+    UFUNCTION(BlueprintPure, Category = "Wind Field|Playback")
+    bool IsPlayingSequence() const { return PlayingSequence != nullptr; }
+
+    UFUNCTION(BlueprintPure, Category = "Wind Field|Playback")
+    float GetSequenceTime() const { return SequencePlayer.GetTime(); }
+
+    /** Blocks until an in-flight async step has finished. Only needed before touching the grid layout. */
+    void WaitForAsyncUpdate();
+
+    // Typed views of the float32 velocity channels, indexed X + Y * SizeX + Z * SizeX * SizeY (Linear GridLayout)
+    // These alias the live front buffer, with bAsyncSimulation use GetGridView instead.
+    // Empty with a packed VelocityPrecision, GetGridView reads every precision.
+    int32 GetNumCells() const { return GetAllocatedCells(); }
+    TConstArrayView<float> GetVelocityX() const { return Velocity.X; }
+    TConstArrayView<float> GetVelocityY() const { return Velocity.Y; }
+    TConstArrayView<float> GetVelocityZ() const { return Velocity.Z; }
+    const FWindVectorChannels& GetVelocityChannels() const { return Velocity; }
+
+    // Read-only sampling view of the last completed step. With bAsyncSimulation the grid it points at
+    // stays untouched for one more completed step after the next one is published.
+    FWindGridView GetGridView() const;
+
+    // Increases whenever GetGridView would return different wind: a step that changed the grid, an injection,
+    // a new interpolation blend, a sequence frame. Read it before the view, a copy tagged with it is then never stale.
+    uint64 GetGridVersion() const { return GridVersion.load(std::memory_order_acquire); }
+
+    /**
+    * Window Z slices (FWindGridView order, SizeX * SizeY cells each) whose wind changed after SinceVersion, so a copy
+    * made at that version can be refreshed in part. False when that is no longer known or was never tracked (a
+    * scroll, a sequence frame, a new grid), the whole copy is stale then.
+    */
+    bool GetDirtySlices(uint64 SinceVersion, TBitArray<>& OutSlices) const;
+
+    // Number of bricks currently simulated in Sparse storage mode
+    int32 GetNumActiveBricks() const { return Bricks.GetNumActiveBricks(); }
+
+    // Tiles stepped by the solver with bSkipQuiescentTiles, out of GetNumActivityTiles
+    int32 GetNumActiveTiles() const { return NumActiveTiles; }
+    int32 GetNumActivityTiles() const { return ActivityTiles.Num(); }
+
+    // True while every tile sleeps, the grid view then returns the same wind every frame
+    bool IsQuiescent() const;
+
+    // Clipmap level 0 is this field, level N > 0 is a coarser child grid with CellSize * 2^N
+    int32 GetNumClipmapLevels() const { return ClipmapLevels.Num() + 1; }
+    const UWindVectorField* GetClipmapLevel(int32 Level) const { return Level == 0 ? this : ClipmapLevels[Level - 1].Get(); }
 
     // ======= Editable Parameters =======
 
@@ -70,7 +239,180 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field", meta = (ToolTip = "Controls how spread out the noise features are (lower = larger features)."))
     float NoiseScale = 0.01f;
 
+    /** Split the solver passes across worker threads. Disable to profile or debug the single-threaded path. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bParallelSolve = true;
+
+    /** How a simulation step walks the grid. Both modes produce the same wind, Fused streams the grid through cache once. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    EWindSolverMode SolverMode = EWindSolverMode::Split;
+
+    /**
+    * MacCormack keeps gust detail at roughly twice the CellSize of semi-Lagrangian advection for about twice the
+    * advection cost. Always steps with the fused solver, the correction needs the full forward prediction first.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    EWindAdvectionScheme AdvectionScheme = EWindAdvectionScheme::SemiLagrangian;
+
+    /** Initialize on a background task when the asset is loaded, instead of warming up on the loading thread */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bAsyncInitialize = true;
+
+    /** Solver steps Initialize runs so the grid starts out settled, 0 starts from still air */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (ClampMin = "0"))
+    int32 WarmUpSteps = 10;
+
+    /** Run Update as a background task. Readers always see the last completed step and never wait on the solver. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bAsyncSimulation = false;
+
+    /**
+    * Step the solver at SimulationRate instead of once per Update, independent of the frame rate.
+    * Samplers and the Niagara upload blend the last two steps by how far the frame is into the next one.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bFixedTimestep = false;
+
+    /** Solver steps per second with bFixedTimestep */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bFixedTimestep", ClampMin = "1.0"))
+    float SimulationRate = 30.0f;
+
+    /** Most steps a single Update may catch up on, time beyond that is dropped instead of spiralling. Async fields run them in one task. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bFixedTimestep", ClampMin = "1"))
+    int32 MaxSubstepsPerUpdate = 4;
+
+    /**
+    * Track activity per 8^3 cell tile and skip the solver for tiles whose wind has stopped changing.
+    * Injections, scrolling and changing neighbours wake a tile up again. Always steps with the fused solver.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bSkipQuiescentTiles = false;
+
+    /** Largest per-step change in cell velocity for which a tile still counts as calm */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bSkipQuiescentTiles", ClampMin = "0.0"))
+    float QuiescenceThreshold = 1.0f;
+
+    /** Consecutive calm steps before a tile goes to sleep */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bSkipQuiescentTiles", ClampMin = "1"))
+    int32 QuiescenceSteps = 30;
+
+    /**
+    * Project every step onto a divergence-free field, so injected wind flows around and swirls instead of piling up.
+    * The pressure is solved with multigrid V-cycles, the window faces are open. Dense storage only.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver")
+    bool bProjectIncompressible = false;
+
+    /** Time the pressure solve may take per step. V-cycles stop once the next one would overrun it, at least one always runs. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bProjectIncompressible", ClampMin = "0.0", Units = "Microseconds"))
+    float PressureBudgetMicroseconds = 500.0f;
+
+    /** Upper bound on V-cycles per step, regardless of the remaining budget */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (EditCondition = "bProjectIncompressible", ClampMin = "1"))
+    int32 MaxPressureVCycles = 4;
+
+    /**
+    * Vorticity confinement, pushes energy back into the eddies that advection and decay smear out so a coarse grid
+    * keeps the swirl of a finer one. 0 disables it, around 0.5 to 2 is a good range. Dense storage only.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Solver", meta = (ClampMin = "0.0"))
+    float VorticityStrength = 0.0f;
+
+    /**
+    * Storage precision of the velocity grids. The 16-bit formats halve the resident grids and are decoded on read,
+    * they always step with the fused solver so every cell is encoded once per step.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Field|Storage")
+    EWindVelocityPrecision VelocityPrecision = EWindVelocityPrecision::Float32;
+
+    /** Int16 storage covers -MaxSpeed..MaxSpeed per component, faster wind saturates */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Field|Storage", meta = (EditCondition = "VelocityPrecision == EWindVelocityPrecision::Int16", ClampMin = "1.0"))
+    float QuantizationMaxSpeed = 4000.0f;
+
+    /**
+    * Memory order of the velocity grids. Tiled keeps 4x4x4 cell blocks together so the trilinear corners of a sample
+    * stay within a couple of cache lines, at the cost of padding each axis to a multiple of 4.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind Field|Storage")
+    EWindGridLayout GridLayout = EWindGridLayout::Linear;
+
+    /**
+    * Keep the grid centred on the scroll target. The window moves in whole cells and is stored as a 3D ring buffer,
+    * so only the slabs that scroll into view are re-seeded from the force field. FieldOrigin is driven by the window.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Scrolling")
+    bool bScrollWithTarget = false;
+
+    /**
+    * Sparse stores only the disturbance on top of the calm-air wind (WindBias * WindScale) in 8^3 cell bricks,
+    * so memory and step cost follow the disturbed volume instead of the grid size. Cells are anchored to world
+    * space (WorldPos / CellSize) and the Size/FieldOrigin/scrolling settings are ignored. Turbulence is not
+    * simulated and the grid is not uploaded to Niagara in this mode.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Sparse")
+    EWindStorageMode StorageMode = EWindStorageMode::Dense;
+
+    /** Disturbance speed below which a brick counts as calm */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Sparse", meta = (EditCondition = "StorageMode == EWindStorageMode::Sparse", ClampMin = "0.0"))
+    float BrickRetireSpeed = 5.0f;
+
+    /** Consecutive calm steps before a brick is released */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Sparse", meta = (EditCondition = "StorageMode == EWindStorageMode::Sparse", ClampMin = "1"))
+    int32 BrickRetireSteps = 30;
+
+    /** Upper bound on simulated bricks (512 cells each), new disturbances are dropped once it is reached */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Sparse", meta = (EditCondition = "StorageMode == EWindStorageMode::Sparse", ClampMin = "1"))
+    int32 MaxActiveBricks = 4096;
+
+    /**
+    * Number of nested grid levels centred on the scroll target, 1 means this grid only. Every extra level covers twice
+    * the extent of the previous one at half the resolution. Sampling uses the finest level that contains the point.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Clipmap", meta = (ClampMin = "1", ClampMax = "6"))
+    int32 NumClipmapLevels = 1;
+
+    /** Step level N every 2^N frames (with the accumulated time) instead of every frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Clipmap", meta = (EditCondition = "NumClipmapLevels > 1"))
+    bool bStaggerClipmapUpdates = true;
+
+    /** Solid cells of ObstacleMask hold no wind, advection sees them as calm walls and injections skip them. Dense storage only. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Obstacles")
+    bool bUseObstacleMask = true;
+
+    /** World box BakeObstacleMask voxelizes, left empty it bakes the grid's current extent */
+    UPROPERTY(EditAnywhere, Category = "Wind Field|Obstacles")
+    FBox ObstacleBakeBounds = FBox(ForceInit);
+
+    /** Collision object type that counts as an obstacle */
+    UPROPERTY(EditAnywhere, Category = "Wind Field|Obstacles")
+    TEnumAsByte<ECollisionChannel> ObstacleObjectType = ECC_WorldStatic;
+
+    /** Baked by BakeObstacleMask, world-anchored so scrolling windows and clipmap levels resample it */
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Obstacles")
+    FWindObstacleMask ObstacleMask;
+
+    /** Solver steps BakeSteadyState runs before it captures the grid */
+    UPROPERTY(EditAnywhere, Category = "Wind Field|Steady State", meta = (ClampMin = "1"))
+    int32 SteadyStateBakeSteps = 300;
+
+    /** Fingerprint of the settings the steady state was baked with, it is ignored once they no longer match */
+    UPROPERTY(VisibleAnywhere, Category = "Wind Field|Steady State")
+    uint32 SteadyStateKey = 0;
+
+    /** Wrap from the last frame of a played sequence back to the first instead of holding it */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Playback")
+    bool bLoopSequence = false;
+
+    /**
+    * Frames decoded ahead of the pair on display. Playback keeps this many plus five decoded grids resident,
+    * raise it if decodes fall behind (the Sequence Stalls stat).
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Field|Playback", meta = (ClampMin = "0", ClampMax = "16"))
+    int32 SequenceReadAheadFrames = 2;
+
 protected:
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void BeginDestroy() override;
     virtual void PostLoad() override;
 #if WITH_EDITOR
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -81,18 +423,230 @@ private:
     bool bIncreasing = false;
     bool bInitialized = false;
     bool isDone = false;
+    bool bForceFieldDirty = true;
+    // The origin moved onto another cell, only the solid bits need resampling
+    bool bSolidCellsDirty = false;
+
+    // Set by the thread that finished the warm-up, the game thread still owes OnReady and the clipmap levels
+    std::atomic<bool> bReady { false };
+
+    // SampleWindBatch runs per VM block, an uninitialized field is reported once rather than every call
+    mutable std::atomic<bool> bWarnedInvalidBatch { false };
+    bool bNotifyReady = false;
+
+    // Setters called while the warm-up task still reads the settings, replayed in order once it finished
+    TArray<TFunction<void()>> DeferredSetters;
+    bool DeferUntilReady(TFunction<void()>&& Setter);
 
-    // Simulation grid
-    TArray<FVector> VelocityGrid;
+    // See GetGridVersion, bumped by whichever thread published the change. Without DirtySlices the whole grid changed.
+    std::atomic<uint64> GridVersion { 1 };
+    void BumpGridVersion(const TBitArray<>* ChangedSlices = nullptr);
+
+    // Slices each of the last versions changed, indexed by version, see GetDirtySlices. Empty for the whole grid.
+    static constexpr int32 GridChangeHistory = 16;
+    struct FGridChange
+    {
+        uint64 Version = 0;
+        TBitArray<> DirtySlices;
+    };
+    FGridChange GridChanges[GridChangeHistory];
+    mutable FCriticalSection GridChangeLock;
+
+    // Slices the step or injection in progress changed, only touched by whoever owns the grid at the time.
+    // The last published step's slices are what a new fixed-rate blend changes.
+    TBitArray<> DirtySlices;
+    TBitArray<> LastStepDirtySlices;
+    FIntVector LastPublishedRingOffset = FIntVector::ZeroValue;
+    void ResetDirtySlices() { DirtySlices.Init(false, SizeZ); }
+    void MarkSlicesDirty(int32 MinZ, int32 MaxZ);
+
+    // Simulation grid (front buffer) and the solver target it is swapped with every step
+    FWindVectorChannels Velocity;
+    FWindVectorChannels BackVelocity;
+
+    // Third buffer of the async triple-buffer, the previous front that readers may still hold
+    FWindVectorChannels RetiredVelocity;
+
+    // Forward prediction of MacCormack advection, float32 at every VelocityPrecision. Empty with semi-Lagrangian.
+    FWindVectorChannels AdvectScratch;
+
+    // The same three buffers for 16-bit VelocityPrecision, only one of the two sets is ever allocated
+    FWindPackedChannels PackedVelocity;
+    FWindPackedChannels PackedBackVelocity;
+    FWindPackedChannels PackedRetiredVelocity;
+
+    // Fourth buffer for async fixed-rate batches of several steps, holds the published front until the batch publishes
+    FWindVectorChannels SubstepVelocity;
+    FWindPackedChannels PackedSubstepVelocity;
+
+    // Guards the front buffer swap against readers grabbing a view
+    mutable FRWLock PublishLock;
+
+    // What GetGridView hands out while a batch steps through fronts nobody was meant to see
+    FWindGridView HeldGridView;
+    bool bHoldGridView = false;
+
+    // Async stepping state
+    UE::Tasks::FTask AsyncStepTask;
+    float PendingAsyncDeltaTime = 0.0f;
+
+    // Fixed-rate stepping, time not yet simulated and the blend it gives between the last two steps
+    float SimulationAccumulator = 0.0f;
+
+    // Blend an async fixed step publishes together with its grid, negative while none is in flight
+    float PendingSimulationAlpha = -1.0f;
+    float SimulationAlpha = 1.0f;
+
+    struct FPendingInjection
+    {
+        FVector WorldPos;
+        FVector Velocity;
+        float Radius;
+    };
+
+    // Injections made while the async solver owns the grid, applied at the end of the next step
+    TArray<FPendingInjection> PendingInjections;
+    // The origin of the step in flight, queued world positions are made grid-relative against it
+    FVector StepFieldOrigin = FVector::ZeroVector;
+    FCriticalSection PendingInjectionLock;
+
+    // Cached per-cell wind force ((WindBias + Turbulence) * WindScale), time invariant between parameter changes
+    FWindVectorChannels Force;
+
+    // ObstacleMask resampled to this grid, one bit per storage cell. Built with the force field, always sized on a
+    // dense grid (all clear without a mask) so the solver can test it without branching.
+    TArray<uint64> SolidCells;
+
+    // Baked steady state, window-ordered float channels VX, VY, VZ, FX, FY, FZ of SizeX * SizeY * SizeZ cells each.
+    // Stored inline so it is resident by PostLoad.
+    FByteBulkData SteadyState;
+
+    // Sparse storage mode, the disturbance relative to the ambient wind
+    FWindBrickGrid Bricks;
+
+    // Sequence playback, the player only holds a raw pointer so the property keeps the asset alive
+    UPROPERTY(Transient)
+    TObjectPtr<UWindSequence> PlayingSequence;
+    FWindSequencePlayer SequencePlayer;
+
+    // Quiescence tracking, one tile per 8^3 block of storage cells. Only sized while bSkipQuiescentTiles is set.
+    static constexpr int32 ActivityTileShift = 3;
+    struct FActivityTile
+    {
+        int32 QuietSteps = 0;
+        float MaxChangeSq = 0.0f;
+    };
+    TArray<FActivityTile> ActivityTiles;
+    FIntVector ActivityTileCounts = FIntVector::ZeroValue;
+    int32 NumActiveTiles = 0;
+
+    // Scratch levels of the incompressibility projection, kept between steps (the last pressure seeds the next solve)
+    FWindPressureSolver PressureSolver;
+
+    // Curl scratch of the vorticity confinement pass
+    FWindVorticityConfinement VorticityConfinement;
+
+    // Whether the step being solved changes the grid, and how many published steps in a row did not
+    bool bStepChangedGrid = true;
+    int32 QuiescentStepCount = 0;
+
+    // Coarser clipmap levels, ClipmapLevels[i] is level i + 1. Owned by this field and rebuilt on reset.
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UWindVectorField>> ClipmapLevels;
+    TArray<float> ClipmapPendingDeltaTime;
+    uint32 ClipmapFrameCounter = 0;
 
     // Noise generator
     FastNoiseLite Noise;
+
+    // Scrolling window, world cell of the window's min corner and the ring offset it maps to in storage
+    FIntVector WindowOriginCell = FIntVector::ZeroValue;
+    FIntVector RingOffset = FIntVector::ZeroValue;
+    bool bScrollWindowValid = false;
+    TWeakObjectPtr<AActor> ScrollTarget;
+    // The Phoenix fallback found nothing, not searched again until SetScrollTarget
+    bool bScrollTargetSearchFailed = false;
     
     // Helpers
     int GetIndex(int X, int Y, int Z) const;
     bool IsValidIndex(int X, int Y, int Z) const;
+    void InitializeGrid();
+    uint32 ComputeSteadyStateKey() const;
+    bool LoadSteadyState();
+    void WarmUp();
+    void NotifyReady();
+    void PrepareStep(bool bUpdateScrollWindow = true);
+    void StepSimulation(float DeltaTime);
+    void StepSimulationBatch(float DeltaTime, int32 NumSteps);
+    void SolveStep(float DeltaTime);
+    void EnsureSubstepBuffer();
+    void LaunchAsyncStep(float DeltaTime);
+    void LaunchAsyncStepTask(float StepDeltaTime, int32 NumSteps);
+    void UpdateFixedRate(float DeltaTime);
+    FWindGridView MakeGridView(bool bInterpolate) const;
+    FWindGridView MakeGridViewLocked(bool bInterpolate) const;
+
+    // The step before the front buffer, kept in the back buffer (sync) or the retired buffer (async)
+    const FWindVectorChannels& GetPreviousVelocity() const { return bAsyncSimulation ? RetiredVelocity : BackVelocity; }
+    FWindVectorChannels& GetPreviousVelocity() { return bAsyncSimulation ? RetiredVelocity : BackVelocity; }
+    const FWindPackedChannels& GetPreviousPackedVelocity() const { return bAsyncSimulation ? PackedRetiredVelocity : PackedBackVelocity; }
+    FWindPackedChannels& GetPreviousPackedVelocity() { return bAsyncSimulation ? PackedRetiredVelocity : PackedBackVelocity; }
+
+    bool IsPacked() const { return VelocityPrecision != EWindVelocityPrecision::Float32 && !IsSparse(); }
+    int32 GetAllocatedCells() const { return IsPacked() ? PackedVelocity.Num() : Velocity.Num(); }
+    int32 GetStorageCellCount() const { return FWindGridView::GetStorageCellCount(GridLayout, SizeX, SizeY, SizeZ); }
+    void AllocateFrontBuffer();
+    void PublishBackBuffer();
+    TArray<FPendingInjection> TakePendingInjections();
+    template<typename ChannelsType>
+    void ApplyPendingInjections(ChannelsType& Target);
+    template<typename ChannelsType>
+    void ApplyInjection(ChannelsType& Target, const FVector& LocalWorldPos, const FVector& VelocityToInject, float Radius);
     void Advect(float DeltaTime);
+    void AdvectSlab(int32 z, float DeltaTime);
+    void EnsureBackBuffer();
+    void StepFused(float DeltaTime);
+    bool IsSparse() const { return StorageMode == EWindStorageMode::Sparse; }
+    void StepSparse(float DeltaTime);
+    void InjectSparse(const FVector& WorldPos, const FVector& VelocityToInject, float Radius);
+    FVector3f GetAmbientWind() const;
+    void SyncClipmapLevels();
+    void ConfigureClipmapLevel(UWindVectorField* Level, int32 LevelIndex) const;
+    FVector GetClipmapLevelOrigin(const UWindVectorField* Level) const;
+    void ApplyClipmapSolverSettings(UWindVectorField* Level, int32 LevelIndex) const;
+    void UpdateClipmapLevels(float DeltaTime);
+    void PropagateForceParameters();
+    void GetClipmapViews(const FWindGridView& FinestView, TArray<FWindGridView, TInlineAllocator<8>>& OutViews) const;
+    template<EWindVelocityPrecision Precision>
+    float StepFusedBlock(const FWindGridView& Front, const FWindGridView* Predicted, const FIntVector& Min, const FIntVector& Max, float DeltaTime, float Decay);
+    template<EWindVelocityPrecision Precision>
+    void PredictBlock(const FWindGridView& Front, const FIntVector& Min, const FIntVector& Max, float DeltaTime, bool bAdvect);
+    bool UsesMacCormack() const { return AdvectScratch.Num() > 0 && AdvectScratch.Num() == GetAllocatedCells(); }
+    FWindGridView MakePredictionView(const FWindGridView& Front) const;
+    void EnsureActivityTiles();
+    void StepActiveTiles(float DeltaTime);
+    void UpdateTileActivity();
+    void GetActivityTileBounds(int32 TileIndex, FIntVector& OutMin, FIntVector& OutMax) const;
+    void WakeTileNeighbourhood(int32 TileIndex);
+    void WakeTiles(const FIntVector& Min, const FIntVector& Max);
+    void WakeAllTiles();
+    template<typename ChannelsType>
+    void ProjectVelocity(ChannelsType& Target);
+    template<typename ChannelsType>
+    void ConfineVorticity(ChannelsType& Target, float DeltaTime);
+    static float GetDecayFactor(float DeltaTime);
+    bool IsObstacleCell(int X, int Y, int Z) const;
+    void SetSolidCell(int32 Index, bool bSolid);
+    void ResampleSolidCells();
+    // 0 for solid storage cells, 1 for open ones
+    FORCEINLINE float GetOpenFactor(int32 Index) const { return (float)((~SolidCells[Index >> 6] >> (Index & 63)) & 1); }
     void DecayVelocity(float DeltaTime);
-    FVector const SampleVelocityAtGridPosition(const FVector& GridPos) const;
+    void ApplyForceField(float DeltaTime);
+    static bool IsForceFieldProperty(FName PropertyName);
+    FVector3f ComputeForceAtCell(const FIntVector& Cell) const;
+    bool GetScrollTargetLocation(FVector& OutLocation);
+    void UpdateScrollWindow();
+    void ReseedRegion(const FIntVector& Min, const FIntVector& Max);
+    FVector3f SampleVelocityAtGridPosition(const FVector3f& GridPos) const;
     FVector GetPhoenixPosition() const;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#pragma once
+#include "CoreMinimal.h"
+#include "WindGridView.h"
+
+/**
+* Vorticity confinement for the dense wind grid (Fedkiw, Stam and Jensen 2001).
+* Works on its own window-ordered copy of the velocity, so every pass is a run of flat row loops the compiler can
+* vectorize. Scratch channels are allocated once and reused between steps.
+*/
+struct EMBERFLIGHT_API FWindVorticityConfinement
+{
+    /** Sizes the scratch grids, a no-op when the size did not change */
+    void Resize(const FIntVector& InSize);
+    void Reset();
+
+    SIZE_T GetAllocatedSize() const;
+
+    // Working grid, indexed X + (Y + Z * SizeY) * SizeX. Filled with the velocity before Compute, holds the change after it.
+    FWindVectorChannels& GetChannels() { return Channels; }
+
+    /**
+    * Replaces the velocity in GetChannels with Strength * CellSize * (N x Curl) * DeltaTime, N the normalized gradient of |Curl|.
+    * Returns false, leaving the channels untouched, on a grid less than two cells along any axis.
+    */
+    bool Compute(float Strength, float CellSize, float DeltaTime, bool bParallel);
+
+private:
+    FIntVector Size = FIntVector::ZeroValue;
+
+    FWindVectorChannels Channels;
+    FWindVectorChannels Curl;
+    FWindVectorChannels::FChannel CurlMagnitude;
+};